@@ -6,6 +6,8 @@
 #include "dl_list.h" /* dl_list */
 
 typedef struct avl avl_t;
+typedef struct avl_iter avl_iter_t;
+typedef struct avl_node avl_node_t;
 typedef int (*compare_func_t)(const void* data, const void* param);
 typedef int (*action_func_t)(void* ,void* );
 typedef int (*is_match_t)(const void* data, const void* param);
@@ -17,6 +19,11 @@ typedef enum
     IN = 2
 } traversal_order_t;
 
+struct avl_iter
+{
+    avl_node_t* node;
+};
+
 /* 
 *   @desc:          Allocates a new AVL which is sorted by @compare_func. 
 *                   Must be destroyed with @AVLDestroy
@@ -31,11 +38,67 @@ avl_t* AVLCreate(compare_func_t compare_func);
 
 
 /* 
-*   @desc:          Frees AVL. Must have been created using @AVLCreate    
+*   @desc:          Allocates a new AVL which is sorted by @compare_func and
+*                   holds the @n_elements elements of @array. The tree is
+*                   built perfectly balanced and all of its nodes share a
+*                   single allocation. Must be destroyed with @AVLDestroy
+*   @params: 	    @compare_func: compare function that the AVL is sorted by
+*                   @array: elements sorted in ascending order of
+*                   @compare_func without duplicates
+*                   @n_elements: number of elements in @array
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func is invalid or @array
+*                   is not sorted
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(n) for both AC/WC
+*/
+avl_t* AVLCreateFromSorted(compare_func_t compare_func, void** array,
+                                                            size_t n_elements);
+
+
+/* 
+*   @desc:          Returns the memory size @AVLCreateInMemory needs to hold
+*                   @n_elements elements
+*   @params: 	    @n_elements: number of elements
+*   @return value:  Memory size in bytes
+*   @error: 		None
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+size_t AVLSuggestSize(size_t n_elements);
+
+
+/* 
+*   @desc:          Allocates a new AVL which is sorted by @compare_func and
+*                   takes its nodes from @memory instead of malloc, through a
+*                   fixed size allocator. Inserting fails once @memory is
+*                   full. @AVLDestroy does not visit the nodes, @memory may
+*                   be reused as a whole once every AVL over it (including
+*                   ones made by @AVLSplit) is destroyed.
+*                   Must be destroyed with @AVLDestroy
+*   @params: 	    @compare_func: compare function that the AVL is sorted by
+*                   @memory: memory for the nodes, see @AVLSuggestSize
+*                   @memory_size: size of @memory in bytes
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails or @memory_size is too small
+*                   for a single node
+*                   Undefined behavior if @compare_func or @memory are
+*                   invalid
+*   @time complex: 	O(memory_size) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+avl_t* AVLCreateInMemory(compare_func_t compare_func, void* memory,
+                                                        size_t memory_size);
+
+
+/* 
+*   @desc:          Frees AVL. Must have been created using @AVLCreate,
+*                   @AVLCreateFromSorted, @AVLCreateInMemory or @AVLSplit    
 *   @params: 	    @avl: AVL to free
 *   @return value:  None
 *   @error: 		Undefined behavior if @avl is not valid
-*   @time complex: 	O(n) for both AC/WC
+*   @time complex: 	O(n) for both AC/WC, O(1) for @AVLCreateInMemory
 *   @space complex: O(n) for both AC/WC
 */
 void AVLDestroy(avl_t* avl);
@@ -50,7 +113,7 @@ void AVLDestroy(avl_t* avl);
 *   @error: 		Returns non zero value if allocation failed
 *                   Undefined behaviour if @avl is invalid                   
 *   @time complex: 	O(log(n)) for both AC/WC
-*   @space complex: O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
 */
 int AVLInsert(avl_t* avl, const void* data);
 
@@ -62,7 +125,7 @@ int AVLInsert(avl_t* avl, const void* data);
 *   @return value:  None
 *   @error: 		Undefined behavior if @avl is invalid.
 *   @time complex: 	O(log(n)) for both AC/WC
-*   @space complex: O(log(n)) for both AC/WC 
+*   @space complex: O(1) for both AC/WC 
 */
 void AVLRemove(avl_t* avl, const void* param);
 
@@ -75,7 +138,7 @@ void AVLRemove(avl_t* avl, const void* param);
 *					NULL if not found.
 *   @error:		    undefined behavior if @avl is invalid
 *   @time complex:  O(log(n)) for both AC/WC
-*   @space complex: O(log(n)) for both AC/WC 
+*   @space complex: O(1) for both AC/WC 
 */
 void* AVLFind(const avl_t* avl, const void* param);
 
@@ -85,12 +148,39 @@ void* AVLFind(const avl_t* avl, const void* param);
 *   @params:        @avl: valid AVL
 *   @return value:  Number of nodes in @avl.
 *   @error:         Undefined beahvior if @avl is invalid.	
-*   @time complex: 	O(n) for both AC/WC
-*   @space complex: O(n) for both AC/WC
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
 */
 size_t AVLGetSize(const avl_t* avl);
 
 
+/* 
+*   @desc:          Returns an iterator to the @k-th smallest element in @avl,
+*                   counting from zero.
+*   @params:        @avl: valid AVL
+*                   @k: zero based order of the element
+*   @return value:  Iterator to the element or end iterator if @k is not
+*                   less than the size of @avl.
+*   @error:         Undefined beahvior if @avl is invalid.	
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+avl_iter_t AVLSelect(const avl_t* avl, size_t k);
+
+
+/* 
+*   @desc:          Counts the elements in @avl which are less than @param.
+*                   If @param is in @avl this is its zero based order.
+*   @params:        @avl: valid AVL
+*                   @param: param to compare the elements with
+*   @return value:  Number of elements less than @param.
+*   @error:         Undefined beahvior if @avl is invalid.	
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t AVLRank(const avl_t* avl, const void* param);
+
+
 /* 
 *   @desc:          Returns the height of @avl     
 *   @params:        @avl: valid AVL
@@ -133,6 +223,172 @@ int AVLForEach(const avl_t* avl, action_func_t action_func, void* param,
 int AVLIsEmpty(const avl_t* avl);
 
 
+/* 
+*   @desc:          Returns an iterator to the first element in @avl which is
+*                   not less than @param.
+*   @params:	    @avl: pre-allocated AVL Tree 
+*                   @param: param to compare the elements with
+*   @return value:  Iterator to the found element or end iterator if all the
+*                   elements are less than @param.
+*   @error:		    undefined behavior if @avl is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC 
+*/
+avl_iter_t AVLLowerBound(const avl_t* avl, const void* param);
+
+
+/* 
+*   @desc:          Returns an iterator to the first element in @avl which is
+*                   greater than @param.
+*   @params:	    @avl: pre-allocated AVL Tree 
+*                   @param: param to compare the elements with
+*   @return value:  Iterator to the found element or end iterator if no
+*                   element is greater than @param.
+*   @error:		    undefined behavior if @avl is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC 
+*/
+avl_iter_t AVLUpperBound(const avl_t* avl, const void* param);
+
+
+/* 
+*   @desc:           Returns an iterator to the first element in @avl.
+*   @params: 	     @avl: valid AVL
+*   @return value:   Iterator to the first element or end iterator if @avl
+*                    is empty.
+*   @error:          Undefined behavior if @avl is invalid.	
+*   @time complex: 	 O(log(n)) for both AC/WC
+*   @space complex:  O(1) for both AC/WC
+*/
+avl_iter_t AVLBegin(const avl_t* avl);
+
+
+/* 
+*   @desc:          Returns invalid iter after the last element of @avl. 
+*   @params: 	    @avl: valid AVL
+*   @return value:  Invalid iter after the last element of @avl.
+*   @error: 		Undefined behavior if @avl is invalid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+avl_iter_t AVLEnd(const avl_t* avl);
+
+
+/* 
+*   @desc:          Returns the next iterator in order.
+*   @params:        @iter: valid iterator which is not the end iterator
+*   @return value:  Returns the next iterator
+*   @error:         Undefined behavior if @iter is invalid		
+*   @time complex: 	O(1) amortized AC and O(log(n)) for WC
+*   @space complex: O(1) for both AC/WC
+*/
+avl_iter_t AVLNext(avl_iter_t iter);
+
+
+/* 
+*   @desc:          Returns the previous iterator in order.
+*   @params:        @iter: valid iterator
+*   @return value:  Returns the previous iterator
+*   @error:         Undefined behavior if @iter is the beginning of the tree.
+*   @time complex: 	O(1) amortized AC and O(log(n)) for WC
+*   @space complex: O(1) for both AC/WC
+*/
+avl_iter_t AVLPrev(avl_iter_t iter);
+
+
+/* 
+*   @desc:          Returns the data of the element @iter is pointing to.
+*                   Removing an element, by @AVLRemove or any removing
+*                   function, invalidates only the iterators to it, elements
+*                   keep their nodes so iterators to the others stay valid.
+*   @params:        @iter: valid iterator which is not the end iterator
+*   @return         Returns the data @iter is pointing to.
+*   @error:         Undefined behavior if @iter is invalid	
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* AVLGetValue(avl_iter_t iter);
+
+
+/* 
+*   @desc:          Checks if @one and @other refer to the same element.
+*   @params: 	    @one: iterator
+*					@other: iterator
+*   @return value:  Returns one if the iterators are the same and zero
+*                   otherwise
+*   @error: 		None
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+int AVLIsSameIter(avl_iter_t one, avl_iter_t other);
+
+
+/* 
+*   @desc:          Finds all the elements in @avl from @from to @to, both
+*                   inclusive, and appends them in order to @out_list
+*   @params: 	    @avl: Valid AVL
+*                   @from: param of the start of the range
+*                   @to: param of the end of the range
+*                   @out_list: doubly linked list to append elements into
+*   @return value:  Return the amount of elements found or negative one if
+*                   allocation failed
+*   @error: 		Undefined behavior if @avl or @out_list are not valid
+*                   Returns negative one if allocation failed
+*   @time complex: 	O(log(n) + k), k is the amount of elements found
+*   @space complex: O(k)
+*/
+ssize_t AVLFindRange(const avl_t* avl, const void* from, const void* to,
+                                                        dl_list_t* out_list);
+
+
+/* 
+*   @desc:          Removes all the elements in @avl from @from to @to, both
+*                   inclusive. The tree is split around the range and the
+*                   remaining parts are joined back, so the removal does not
+*                   rebalance once per element
+*   @params: 	    @avl: Valid AVL
+*                   @from: param of the start of the range
+*                   @to: param of the end of the range
+*   @return value:  Return the amount of elements removed
+*   @error: 		Undefined behavior if @avl is not valid
+*   @time complex: 	O(log(n) + k), k is the amount of elements removed
+*   @space complex: O(log(n))
+*/
+size_t AVLRemoveRange(avl_t* avl, const void* from, const void* to);
+
+
+/* 
+*   @desc:          Moves all the elements of @src into @dst. @src is left
+*                   empty and must still be destroyed by the user
+*   @params: 	    @dst: Valid AVL
+*                   @src: Valid AVL with the same compare function whose
+*                   elements are all greater than the elements of @dst
+*   @return value:  None
+*   @error: 		Undefined behavior if @dst or @src are not valid, are the
+*                   same AVL, their elements overlap or they do not take
+*                   their nodes from the same memory
+*   @time complex: 	O(log(n + m))
+*   @space complex: O(log(n + m))
+*/
+void AVLJoin(avl_t* dst, avl_t* src);
+
+
+/* 
+*   @desc:          Moves all the elements of @avl which are not less than
+*                   @param into a new AVL, which takes its nodes from the same
+*                   memory as @avl. Must be destroyed with @AVLDestroy
+*   @params: 	    @avl: Valid AVL
+*                   @param: param to split the elements by
+*   @return value:  Pointer to the new AVL
+*   @error: 		NULL if allocation fails, in which case @avl is left
+*                   unchanged
+*                   Undefined behavior if @avl is not valid
+*   @time complex: 	O(log(n))
+*   @space complex: O(log(n))
+*/
+avl_t* AVLSplit(avl_t* avl, const void* param);
+
+
 /* 
 *   @desc:          Finds all instances matching @match_func with @param and
 *                   puts them in @out_list         
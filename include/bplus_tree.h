@@ -0,0 +1,224 @@
+#ifndef __BPLUS_TREE_H__
+#define __BPLUS_TREE_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   In memory B+ tree. Every node holds many elements in a few cache lines, so
+*   a lookup touches far fewer cache lines than in a binary tree, and the
+*   leaves are linked for fast ordered scans.
+*/
+typedef struct bplus_tree bplus_tree_t;
+typedef struct bpt_iter bpt_iter_t;
+typedef struct bpt_leaf bpt_leaf_t;
+typedef int (*compare_func_t)(const void*, const void*);
+typedef int (*action_func_t)(void* data,void* param);
+
+struct bpt_iter
+{
+    bpt_leaf_t* leaf;
+    size_t index;
+};
+
+/*
+*   @desc:          Allocates a new B+ tree which is sorted by @compare_func.
+*                   Must be destroyed with @BPTDestroy
+*   @params: 	    @compare_func: compare function that the tree is sorted by
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func is invalid
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+bplus_tree_t* BPTCreate(compare_func_t compare_func);
+
+/*
+*   @desc:          Frees the tree. Must have been created using @BPTCreate
+*   @params: 	    @tree: tree to free
+*   @return value:  None
+*   @error: 		Undefined behavior if @tree is not valid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+void BPTDestroy(bplus_tree_t* tree);
+
+/*
+*   @desc:          Inserts @data at the appropiate location in @tree based on
+*                   the tree's compare function.
+*   @params: 	    @tree: pre-allocated tree.
+*                   @data: data to insert, must not already be in @tree.
+*   @return value:  Returns zero if insert was successful and non zero
+*                   otherwise
+*   @error: 		Returns non zero value if allocation failed, in which case
+*                   @tree is left unchanged.
+*                   Undefined behaviour if @tree is invalid.
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+int BPTInsert(bplus_tree_t* tree, const void* data);
+
+/*
+*   @desc:          Removes the element matching @param from @tree.
+*   @params: 	    @tree: pre-allocated tree.
+*                   @param: param to remove from @tree.
+*   @return value:  returns the data of the removed element or NULL if not
+*                   found.
+*   @error: 		Undefined behavior if @tree is invalid.
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* BPTRemove(bplus_tree_t* tree, const void* param);
+
+/*
+*   @desc:          finds @param in @tree.
+*   @params:	    @tree: pre-allocated tree.
+*                   @param: param to find in @tree.
+*   @return value:  returns the data of the found element or NULL if not
+*                   found.
+*   @error:		    undefined behavior if @tree is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* BPTFind(const bplus_tree_t* tree, const void* param);
+
+/*
+*   @desc:          Returns an iterator to the first element in @tree which is
+*                   not less than @param.
+*   @params:	    @tree: pre-allocated tree.
+*                   @param: param to compare the elements with.
+*   @return value:  Iterator to the found element or end iterator if all the
+*                   elements are less than @param.
+*   @error:		    undefined behavior if @tree is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+bpt_iter_t BPTLowerBound(const bplus_tree_t* tree, const void* param);
+
+/*
+*   @desc:          Returns an iterator to the first element in @tree which is
+*                   greater than @param.
+*   @params:	    @tree: pre-allocated tree.
+*                   @param: param to compare the elements with.
+*   @return value:  Iterator to the found element or end iterator if no
+*                   element is greater than @param.
+*   @error:		    undefined behavior if @tree is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+bpt_iter_t BPTUpperBound(const bplus_tree_t* tree, const void* param);
+
+/*
+*   @desc:           Returns an iterator to the first element in @tree.
+*   @params: 	     @tree: valid tree.
+*   @return value:   Iterator to the first element.
+*   @error:          Undefined behavior if @tree is invalid.
+*   @time complex: 	 O(1)
+*   @space complex:  O(1)
+*/
+bpt_iter_t BPTBegin(const bplus_tree_t* tree);
+
+/*
+*   @desc:          Returns invalid iter after the last element of @tree.
+*   @params: 	    @tree: valid tree.
+*   @return value:  Invalid iter after the last element of @tree.
+*   @error: 		Undefined behavior if @tree is invalid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+bpt_iter_t BPTEnd(const bplus_tree_t* tree);
+
+/*
+*   @desc:          Returns the next iterator. Iterators are invalidated by
+*                   @BPTInsert and @BPTRemove.
+*   @params:        @iter: valid iterator which is not the end iterator
+*   @return value:  Returns the next iterator
+*   @error:         Undefined behavior if @iter is invalid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+bpt_iter_t BPTNext(bpt_iter_t iter);
+
+/*
+*   @desc:          Returns the previous iterator.
+*   @params:        @iter: valid iterator
+*   @return value:  Return the previous iterator.
+*   @error:         Undefined behavior if @iter is the beginning of the tree.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+bpt_iter_t BPTPrev(bpt_iter_t iter);
+
+/*
+*   @desc:          Returns the value of the element iter is pointing to.
+*   @params:        @iter: valid iterator which is not the end iterator
+*   @return         Returns the value iter is pointing to.
+*   @error:         Undefined behavior if @iter is invalid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+void* BPTGetValue(bpt_iter_t iter);
+
+/*
+*   @desc:          Checks if @one and @other refer to the same element.
+*   @params: 	    @one: iterator
+*					@other: iterator
+*   @return value:  Returns 1 if the iterators are the same and 0 otherwise
+*   @error: 		None
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+int BPTIsSameIter(bpt_iter_t one, bpt_iter_t other);
+
+/*
+*   @desc:          Iterates over each element in range from @from(inclusive)
+*					to @to(exclusive) and performs @action_func with @param and
+*					said element. With @BPTLowerBound and @BPTUpperBound this
+*					is a range scan.
+*   @params: 		@from: valid iterator to start action on
+*					@to: iterator to end of range.
+*					@action_func: a function that does user defined actions
+*                   on elements data and returns 0 upon success
+*					@param: a user defined additional parameter to pass into
+*					@action_func
+*   @return value: 	Returns 0 if the function performed successfully otherwise
+*					returns @action_func return value
+*   @error: 		Undefined behavior if @from is invalid or @to is before
+*					@from or if @action_func is not valid.
+*   @time complex: 	O(k) * O(@action_func)
+*   @space complex: O(@action_func)
+*/
+int BPTForEach(bpt_iter_t from, bpt_iter_t to, action_func_t action_func,
+                                                                void* param);
+
+/*
+*   @desc:          Returns the number of elements in @tree
+*   @params:        @tree: valid tree
+*   @return value:  Number of elements in @tree.
+*   @error:         Undefined beahvior if @tree is invalid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+size_t BPTGetSize(const bplus_tree_t* tree);
+
+/*
+*   @desc:          Returns the number of levels in @tree, one for a tree
+*                   which is a single leaf
+*   @params:        @tree: valid tree
+*   @return value:  Height of @tree.
+*   @error:         Undefined beahvior if @tree is invalid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+size_t BPTGetHeight(const bplus_tree_t* tree);
+
+/*
+*   @desc:          Checks if @tree is empty.
+*   @params: 	    @tree: Valid tree.
+*   @return value:  Return 1 if the @tree is empty , 0 otherwise.
+*   @error: 		Undefined behavior if @tree is not valid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+int BPTIsEmpty(const bplus_tree_t* tree);
+
+#endif      /* __BPLUS_TREE_H__ */
@@ -12,8 +12,16 @@ typedef int (*action_func_t)(void* data,void* param);
 struct bst_iter
 {
     bst_node_t* node;
+    bst_t* bst;         /* the tree @node is in, so removing needs no walk */
 };
 
+typedef enum
+{
+    BST_UNBALANCED = 0,
+    BST_TREAP = 1,
+    BST_SPLAY = 2
+} bst_balance_t;
+
 /* 
 *   @desc:          Allocates a new BST which is sorted by @compare_func. 
 *                   Must be destroyed with @BSTDestroy
@@ -27,11 +35,66 @@ struct bst_iter
 bst_t* BSTCreate(compare_func_t compare_func);
 
 /* 
-*   @desc:          Frees BST. Must have been created using @BSTCreate    
+*   @desc:          Allocates a new BST which is sorted by @compare_func and
+*                   balanced by @balance. With @BST_TREAP every node gets a
+*                   random priority and is rotated to keep the priorities
+*                   heap ordered, so the tree has an expected height of
+*                   O(log(n)) whatever order the elements are inserted in.
+*                   With @BST_SPLAY @BSTFind, @BSTInsert and @BSTRemove move
+*                   the node they reach to the root, so recently used
+*                   elements are found fast, at O(log(n)) amortized per
+*                   operation. @BSTFind then changes the tree and must not
+*                   run concurrently with any other operation.
+*                   Must be destroyed with @BSTDestroy
+*   @params: 	    @compare_func: compare function that the BST is sorted by
+*                   @balance: @BST_UNBALANCED, @BST_TREAP or @BST_SPLAY
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @CompareFunc is invalid
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+bst_t* BSTCreateEx(compare_func_t compare_func, bst_balance_t balance);
+
+/* 
+*   @desc:          Returns the memory size @BSTCreateInMemory needs to hold
+*                   @n_elements elements
+*   @params: 	    @n_elements: number of elements
+*   @return value:  Memory size in bytes
+*   @error: 		None
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+size_t BSTSuggestSize(size_t n_elements);
+
+/* 
+*   @desc:          Allocates a new BST which is sorted by @compare_func and
+*                   takes its nodes from @memory instead of malloc, through a
+*                   fixed size allocator. Inserting fails once @memory is
+*                   full. @BSTDestroy does not visit the nodes, @memory may
+*                   be reused as a whole once the BST is destroyed.
+*                   Must be destroyed with @BSTDestroy
+*   @params: 	    @compare_func: compare function that the BST is sorted by
+*                   @memory: memory for the nodes, see @BSTSuggestSize
+*                   @memory_size: size of @memory in bytes
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails or @memory_size is too small
+*                   for a single node
+*                   Undefined behavior if @compare_func or @memory are
+*                   invalid
+*   @time complex: 	O(memory_size) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+bst_t* BSTCreateInMemory(compare_func_t compare_func, void* memory,
+                                                        size_t memory_size);
+
+/* 
+*   @desc:          Frees BST. Must have been created using @BSTCreate,
+*                   @BSTCreateEx or @BSTCreateInMemory
 *   @params: 	    @bst: BST to free
 *   @return value:  None
 *   @error: 		Undefined behavior if @bst is not valid
-*   @time complex: 	O(n) for both AC/WC
+*   @time complex: 	O(n) for both AC/WC, O(1) for @BSTCreateInMemory
 *   @space complex: O(1) for both AC/WC
 */
 void BSTDestroy(bst_t* bst);
@@ -44,7 +107,7 @@ void BSTDestroy(bst_t* bst);
 *   @return value:  Returns the newly added iterator
 *   @error: 		Returns invalid iterator if allocation failed.
 *                   Undefined behaviour if @bst is invalid.                   
-*   @time complex: 	AC:O(log(n)) ,WC:O(n)
+*   @time complex: 	AC:O(log(n)) ,WC:O(n), expected O(log(n)) for @BST_TREAP
 *   @space complex: O(1) for both AC/WC 
 */
 bst_iter_t BSTInsert(bst_t* bst, const void* data);
@@ -54,7 +117,7 @@ bst_iter_t BSTInsert(bst_t* bst, const void* data);
 *   @params: 	    @iter: iter to remove.
 *   @return value:  returns the data @iter holds.
 *   @error: 		Undefined behavior if @iter is invalid.
-*   @time complex: 	AC:O(log(n)) ,WC:O(n)
+*   @time complex: 	AC:O(log(n)) ,WC:O(n), expected O(log(n)) for @BST_TREAP
 *   @space complex: O(1) for both AC/WC 
 */
 void* BSTRemove(bst_iter_t iter);
@@ -66,7 +129,7 @@ void* BSTRemove(bst_iter_t iter);
 *   @return value:  returns iter to the found ocuurance of @data or
 *					invalid	iter if not found.
 *   @error:		    undefined behavior if @bst is invalid
-*   @time complex:  AC:O(log(n)) , WC:O(n)
+*   @time complex:  AC:O(log(n)) , WC:O(n), expected O(log(n)) for @BST_TREAP
 *   @space complex: O(1) for both AC/WC 
 */
 bst_iter_t BSTFind(const bst_t* bst, const void* data);
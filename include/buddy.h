@@ -0,0 +1,69 @@
+#ifndef __BUDDY_H__
+#define __BUDDY_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   Binary buddy allocator. Blocks are powers of two of a minimum block size,
+*   a block is split in halves until it fits and is merged back with its free
+*   half, its buddy, once freed, so free memory never stays split into pieces
+*   that could form a bigger block. Every size keeps a free list and a bitmap
+*   of its free blocks, blocks carry no header.
+*   Uses Bit Array for the bitmaps.
+*/
+typedef struct buddy buddy_t;
+
+/*
+*   @desc:          Initializes a buddy allocator in a memory pool. The
+*                   allocator metadata is kept at the start of the pool.
+*   @params:        @memory: Pointer to the start of the preallocated memory
+*                   block.
+*				    @memory_size : Total memory size in bytes.
+*   @return value:  Pointer to the buddy structure, and returns NULL if
+*                   @memory_size is not big enough for the structure and a
+*                   single block.
+*   @error: 		Undefined behavior if @memory is invalid and
+*                   allocated less memory than @memory_size.
+*   @time complex: 	O(n)
+*   @space complex: O(1)
+*/
+buddy_t* BuddyInit(void* memory, size_t memory_size);
+
+/*
+*   @desc:          Returns the pointer to a new allocated block, at least
+*                   @alloc_size bytes, rounded up to a power of two of the
+*                   minimum block size.
+*   @params: 	    @buddy: pointer to pre-initialized @buddy.
+*                   @alloc_size: size to allocate.
+*   @return value:  Returns NULL if no free block is big enough or if
+*                   @alloc_size is 0
+*   @error: 		Undefined behavior if @buddy is invalid.
+*   @time complex: 	O(log(n))
+*   @space complex: O(1)
+*/
+void* BuddyAlloc(buddy_t* buddy, size_t alloc_size);
+
+/*
+*   @desc:          Frees a pre-allocated memory block and merges it with its
+*                   free buddies. if @block is NULL no operation will be
+*                   performed.
+*   @params: 	    @buddy: pointer to the @buddy @block was allocated from.
+*                   @block: Pointer to pre-allocated block
+*   @return value:  None
+*   @error: 		Undefined behavior if @buddy or @block are incorrect
+*   @time complex: 	O(log(n))
+*   @space complex: O(1)
+*/
+void BuddyFree(buddy_t* buddy, void* block);
+
+/*
+*   @desc:          Returns the size of the largest available memory block.
+*   @params:        @buddy: Pointer to the initialized @buddy.
+*   @return value:  Size of the largest free block in bytes.
+*   @error:         Returns 0 if no free blocks are available.
+*   @time complex:  O(log(n))
+*   @space complex: O(1)
+*/
+size_t BuddyLargestChunkAvailable(const buddy_t* buddy);
+
+#endif      /* __BUDDY_H__ */
@@ -0,0 +1,118 @@
+#ifndef __CONCURRENT_AVL_H__
+#define __CONCURRENT_AVL_H__
+
+#include <stddef.h>		/* size_t */
+
+#include "avl.h"        /* compare_func_t, action_func_t, traversal_order_t */
+
+/*
+*   Thread safe ordered map for read mostly workloads, built on top of avl.c.
+*   The reader-writer lock is split into one slot per online CPU, each on its
+*   own cache line. A thread always read locks the same slot, so readers on
+*   different slots search concurrently without writing to a shared cache
+*   line. Writers lock every slot before changing the tree, which makes them
+*   more expensive than with a single lock.
+*   Built on POSIX threads, link with -pthread.
+*/
+typedef struct concurrent_avl concurrent_avl_t;
+
+/*
+*   @desc:          Allocates a new map which is sorted by @compare_func.
+*                   Must be destroyed with @CAVLDestroy
+*   @params: 	    @compare_func: compare function that the map is sorted by
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func is invalid
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+concurrent_avl_t* CAVLCreate(compare_func_t compare_func);
+
+/*
+*   @desc:          Frees the map. No other thread may use @map anymore.
+*   @params: 	    @map: map to free
+*   @return value:  None
+*   @error: 		Undefined behavior if @map is not valid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(n) for both AC/WC
+*/
+void CAVLDestroy(concurrent_avl_t* map);
+
+/*
+*   @desc:          Inserts @data to @map. Thread safe, waits for the readers
+*                   of every slot.
+*   @params: 	    @map: valid map
+*                   @data: data to insert
+*   @return value:  Returns zero if insert was successful and non zero
+*                   otherwise
+*   @error: 		Returns non zero value if allocation failed
+*                   Undefined behaviour if @map is invalid
+*   @time complex: 	O(log(n) + number of slots) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+int CAVLInsert(concurrent_avl_t* map, const void* data);
+
+/*
+*   @desc:          Removes the element matching @param from @map. Thread
+*                   safe, waits for the readers of every slot.
+*   @params: 	    @map: valid map
+*                   @param: param to remove
+*   @return value:  None
+*   @error: 		Undefined behaviour if @map is invalid
+*   @time complex: 	O(log(n) + number of slots) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void CAVLRemove(concurrent_avl_t* map, const void* param);
+
+/*
+*   @desc:          Finds @param in @map. Thread safe, runs concurrently with
+*                   the other readers.
+*   @params:	    @map: valid map
+*                   @param: param to find
+*   @return value:  returns the data of the found element or NULL if not
+*                   found.
+*   @error:		    undefined behavior if @map is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* CAVLFind(concurrent_avl_t* map, const void* param);
+
+/*
+*   @desc:          Performs @action_func on each element of @map in @order
+*                   while holding a read lock, so @action_func must not change
+*                   @map. Thread safe, runs concurrently with the other
+*                   readers.
+*   @params:        @map: valid map
+*                   @action_func: function to perform, returns 0 on success
+*                   @param: param for @action_func
+*                   @order: traversal order
+*   @return value:  0 if @action_func succeeded for all of the elements,
+*                   otherwise the value @action_func failed with.
+*   @error:         Undefined behavior if @map or @action_func are invalid.
+*   @time complex: 	O(n) * O(@action_func)
+*   @space complex: O(log(n)) + O(@action_func)
+*/
+int CAVLForEach(concurrent_avl_t* map, action_func_t action_func, void* param,
+                                                    traversal_order_t order);
+
+/*
+*   @desc:          Returns the number of elements in @map. Thread safe.
+*   @params:        @map: valid map
+*   @return value:  Number of elements in @map
+*   @error:         Undefined beahvior if @map is invalid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t CAVLGetSize(concurrent_avl_t* map);
+
+/*
+*   @desc:          Checks if @map is empty. Thread safe.
+*   @params: 	    @map: valid map
+*   @return value:  Return one if @map is empty and zero otherwise.
+*   @error: 		Undefined behavior if @map is not valid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+int CAVLIsEmpty(concurrent_avl_t* map);
+
+#endif  /* __CONCURRENT_AVL_H__ */
@@ -0,0 +1,120 @@
+#ifndef __CONCURRENT_PQ_H__
+#define __CONCURRENT_PQ_H__
+
+#include <stddef.h>		/* size_t */
+
+/*
+*   Relaxed thread safe priority queue (MultiQueue). The elements are spread
+*   over several binary heaps, each behind its own lock, so concurrent
+*   enqueues and dequeues rarely contend. A dequeue returns the better of the
+*   first elements of two randomly chosen heaps, which is close to, but not
+*   always, the first element of the whole queue.
+*   Built on top of heap.c and POSIX threads, link with -pthread.
+*/
+typedef struct priority_queue concurrent_pq_t;
+
+/*
+*   @desc:          Allocates Priority Queue with two heaps per online CPU.
+*   @params: 		@priority_func: Compare function that the priority is sorted
+*									by.
+*   @return value:  Pointer to the allocated Priority Queue
+*   @error: 		NULL if allocation fails
+*					Undefined behavior if @compare_func is not valid
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+concurrent_pq_t* PQCreate(int (*compare_func)(const void*, const void*));
+
+/*
+*   @desc: 	        Frees Priority Queue. Must be created using @PQCreate and
+*					no other thread may use @pq anymore.
+*   @params: 	    @pq: Priority queue to free.
+*   @return value: 	None
+*   @error: 		Undefined behavior if @pq is not valid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void PQDestroy(concurrent_pq_t* pq);
+
+/*
+*   @desc: 	        Enqueues an item to @pq with @data, which must not be NULL.
+*					Thread safe.
+*   @params: 	    @pq : pre allocated priority queue.
+*				    @data: data of the new element
+*   @return value: 	returns 0 on success
+*   @error: 		In the event insertion fails(due to allocation) will return
+* 				    non zero value.
+*					Undefined Behavior if @pq is not valid or @data is NULL.
+*   @time complex: 	O(log(n)) AC and O(n) for WC
+*   @space complex: O(1) AC and O(n) for WC
+*/
+int PQEnqueue(concurrent_pq_t* pq, void* data);
+
+/*
+*   @desc:		   	Removes one of the first elements from @pq. Thread safe.
+*   @params: 	   	@pq : pre allocated priority queue.
+*   @return value: 	Returns the data of the removed element or NULL if every
+*					heap of @pq was found empty
+*   @error: 	   	Undefined Behavior if @pq is invalid.
+*   @time complex: 	O(log(n)) AC and O(n) for WC.
+*   @space complex: O(1) AC and O(n) for WC.
+*/
+void* PQDequeue(concurrent_pq_t* pq);
+
+/*
+*   @desc: 		   	Returns the data of the first element in @pq. Thread safe,
+*					but other threads may change the first element before
+*					it is used.
+*   @params: 	   	@pq : pre allocated priority queue.
+*   @return value: 	The data of the first element or NULL if @pq is empty.
+*   @error: 	   	Undefined behavior if @pq is invalid.
+*   @time complex: 	O(number of heaps) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+void* PQPeek(const concurrent_pq_t* pq);
+
+/*
+*   @desc: 		   	Checks if @pq is empty. Thread safe, the result is a
+*					snapshot.
+*   @params: 	   	@pq : pre allocated priority queue.
+*   @return value: 	1 if the queue is empty 0 otherwise.
+*   @error: 	   	Undefined behavior if @pq is invalid.
+*   @time complex: 	O(number of heaps) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+int PQIsEmpty(const concurrent_pq_t* pq);
+
+/*
+*   @desc: 	        Returns the number of elements in @pq. Thread safe, the
+*					result is a snapshot.
+*   @params: 		@pq : pre allocated priority queue.
+*   @return value: 	Number of elements in the queue.
+*   @error: 		Undefined behavior if @pq is invalid.
+*   @time complex: 	O(number of heaps) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+size_t PQSize(const concurrent_pq_t* pq);
+
+/*
+*   @desc: 	        Removes all the elements in @pq. Thread safe.
+*   @params: 		@pq : pre allocated priority queue.
+*   @return value: 	None
+*   @error: 		Undefined behavior if @pq is invalid.
+*   @time complex: 	O(number of heaps) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+void PQClear(concurrent_pq_t* pq);
+/*
+*   @desc:          Removes the first element matching @param in @is_match param
+*					and returns its value. Will return NULL if not found such
+*					element. Thread safe.
+*   @params:        @pq : pre allocated priority queue.
+*	@return value:	The data of the erased element if found and NULL otherwise
+*	@error:			Undefined behavior if @is_match or @pq is invalid
+*	@time complex:	O(n) for both AC/WC.
+*	@space complex:	O(1) for both AC/WC.
+*/
+void* PQErase(concurrent_pq_t* pq, int (*is_match)(const void*, const void*),
+                                                            const void* param);
+
+#endif  /* __CONCURRENT_PQ_H__ */
@@ -11,6 +11,15 @@ typedef struct dvector dvector_t;
 *  @return value: function returns a pointer to stack if succeeded  or NULL if failed
 */
 dvector_t* DvectorCreate(size_t capacity, size_t element_size);
+
+/* 
+*  @desc:         Allocates dvector as @DvectorCreate, with the array starting at an address aligned to @align,
+*                 also after every resize.
+*  @params:       @capacity of dynamic vector (number of elements), element_size (sizeof elements in bytes)
+*                 and @align (alignment in bytes, 0 for the alignment of malloc)
+*  @return value: function returns a pointer to stack if succeeded  or NULL if failed
+*/
+dvector_t* DvectorCreateAligned(size_t capacity, size_t element_size, size_t align);
 /*
 *   @Desc: Free the memory allocated for dvector_t
 *   @Params: @dvector - pointer to a pre-allocated dvector_t data type
@@ -50,17 +59,33 @@ void DvectorGetElement(const dvector_t* dvector, size_t index, void* dest);
 int DvectorPushBack(dvector_t* dvector, const void* element);
 
 /*
-*   @Desc: Pop out the element at size index in dvector
+*   @Desc: Push @n_elements elements stored contiguously at @elements to the end of the dvector.
+*          The capacity is grown at most once for the whole batch, geometrically as in DvectorPushBack.
+*   @Params: Pointer to a pre-allocated dvector_t data type, pointer to the elements, number of elements.
+*   @Return: Return success (0) or failure (1)
+*/
+int DvectorPushBackMany(dvector_t* dvector, const void* elements, size_t n_elements);
+
+/*
+*   @Desc: Pop out the element at size index in dvector. Once the size drops to a quarter of the
+*          capacity, the capacity is shrunk to one and a half times the size.
 *   @Params: Pointer to a pre-allocated dvector_t data type.
 *   @Return: Return success (0) or failure (1). If this element is required use DvectorGetElement before.
 */
 
 int DvectorPopBack(dvector_t* dvector);
 
+/*
+*   @Desc: Removes all the elements in the dvector without changing its capacity
+*   @Params: Pointer to a pre-allocated dvector_t data type.
+*   @Return: Void function
+*/
+void DvectorClear(dvector_t* dvector);
+
 /*
 *   @Desc: Update the capacity of the dvector
 *   @Params: pointer to a pre-allocated dvector_t data type, size_t new capacity for the dvector
-*   @Return: (0) if success or (1) for failure
+*   @Return: (0) if success or (1) for failure, in which case the dvector is left unchanged
 */
 
 int DvectorResize(dvector_t* dvector, size_t new_capacity);
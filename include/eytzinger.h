@@ -0,0 +1,94 @@
+#ifndef __EYTZINGER_H__
+#define __EYTZINGER_H__
+
+#include <stddef.h> /* size_t */
+
+#include "avl.h"    /* avl_t, compare_func_t */
+
+/*
+*   Read only search array in Eytzinger (BFS) order. The implicit tree keeps
+*   the top levels, which every search goes through, in the first few cache
+*   lines. A search walks down without branching on the compare result and
+*   prefetches the cache line that holds the nodes three levels down.
+*   Must be rebuilt when the elements change.
+*/
+typedef struct eytzinger eytzinger_t;
+
+/*
+*   @desc:          Allocates a search array holding the @n_elements elements
+*                   of @array. Must be destroyed with @EytzingerDestroy
+*   @params: 	    @compare_func: compare function @array is sorted by
+*                   @array: elements sorted in ascending order of
+*                   @compare_func without duplicates
+*                   @n_elements: number of elements in @array
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func is invalid or @array
+*                   is not sorted
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(n) for both AC/WC
+*/
+eytzinger_t* EytzingerCreate(compare_func_t compare_func, void** array,
+                                                            size_t n_elements);
+
+/*
+*   @desc:          Allocates a search array holding the elements of @avl,
+*                   read by an in-order walk. Must be destroyed with
+*                   @EytzingerDestroy
+*   @params: 	    @compare_func: compare function @avl is sorted by
+*                   @avl: valid AVL
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func or @avl are invalid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(n) for both AC/WC
+*/
+eytzinger_t* EytzingerCreateFromAVL(compare_func_t compare_func,
+                                                            const avl_t* avl);
+
+/*
+*   @desc:          Frees @eytzinger
+*   @params: 	    @eytzinger: search array to free
+*   @return value:  None
+*   @error: 		Undefined behavior if @eytzinger is not valid
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void EytzingerDestroy(eytzinger_t* eytzinger);
+
+/*
+*   @desc:          Finds @param in @eytzinger
+*   @params:	    @eytzinger: valid search array
+*                   @param: param to find
+*   @return value:  returns the data of the found element or NULL if not
+*                   found.
+*   @error:		    undefined behavior if @eytzinger is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* EytzingerFind(const eytzinger_t* eytzinger, const void* param);
+
+/*
+*   @desc:          Finds the first element in @eytzinger which is not less
+*                   than @param
+*   @params:	    @eytzinger: valid search array
+*                   @param: param to compare the elements with
+*   @return value:  returns the data of the found element or NULL if all the
+*                   elements are less than @param.
+*   @error:		    undefined behavior if @eytzinger is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* EytzingerLowerBound(const eytzinger_t* eytzinger, const void* param);
+
+/*
+*   @desc:          Returns the number of elements in @eytzinger
+*   @params:        @eytzinger: valid search array
+*   @return value:  Number of elements
+*   @error:         Undefined beahvior if @eytzinger is invalid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+size_t EytzingerGetSize(const eytzinger_t* eytzinger);
+
+#endif      /* __EYTZINGER_H__ */
@@ -5,6 +5,14 @@
 
 typedef struct fsa fsa_t;
 
+typedef struct fsa_stats
+{
+    size_t block_size;          /* bytes in a block, rounded up to words */
+    size_t blocks_in_use;
+    size_t peak_blocks_in_use;  /* most blocks in use at once */
+    size_t free_blocks;
+} fsa_stats_t;
+
 /* 
 *   @desc:          Returns the suggested size of memory according to 
 *                   @block_size and @n_blocks.
@@ -31,13 +39,43 @@ size_t FSASuggestSize(size_t block_size, size_t n_blocks);
 */
 fsa_t* FSAInit(void* memory, size_t block_size, size_t memory_size);
 
+/* 
+*   @desc:          Returns the suggested size of memory for @FSAInitBitmap
+*                   according to @block_size and @n_blocks.
+*   @params: 	    @block_size: the number of bytes in block
+*				    @n_blocks: the number of blocks
+*   @return value:  The suggested total memory size.
+*   @error: 		None.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t FSASuggestBitmapSize(size_t block_size, size_t n_blocks);
+
+/* 
+*   @desc:          Creates and initilizes the FSA structure, keeping the
+*                   free blocks in a bitmap after the structure instead of a
+*                   header in every block. Blocks are packed with no header,
+*                   and an allocation reads the bitmap, not the block. The
+*                   rest of the FSA functions work the same on it.
+*   @params: 	    @memory: Pointer to the start of the preallocated memory block.
+*                   @block_size: Block size in bytes.
+*				    @memory_size : Total memory size in bytes.
+*   @return value:  Pointer to the FSA structure.
+*   @error: 		Returns NULL if @memory_size does not fit a block
+*                   undefined behavior if @memory is invalid and
+*                   allocated less memory than @memory_size.
+*   @time complex: 	O(n / 64) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+fsa_t* FSAInitBitmap(void* memory, size_t block_size, size_t memory_size);
+
 /* 
 *   @desc:          Returns the pointer to the first empty block.
 *   @params: 	    @fsa: Pre-initialized FSA structure.
 *   @return value:  Returns a pointer to an allocated block
 *   @error: 		Returns NULL if no free block available
 *                   undefined behavior if @fsa is invalid
-*   @time complex: 	O(1) for both AC/WC
+*   @time complex: 	O(1) for both AC/WC, O(n / 64) WC for @FSAInitBitmap
 *   @space complex: O(1) for both AC/WC
 */
 void* FSAAlloc(fsa_t* fsa);
@@ -53,15 +91,54 @@ void* FSAAlloc(fsa_t* fsa);
 */
 void FSAFree(fsa_t* fsa, void* p_block);
 
+/* 
+*   @desc:          Allocates up to @n_blocks blocks at once into @blocks.
+*                   The free blocks are detached from @fsa as one chain, and
+*                   @fsa is updated once.
+*   @params: 	    @fsa: Pre-initialized FSA structure.
+*                   @blocks: array of at least @n_blocks pointers to fill.
+*                   @n_blocks: the number of blocks to allocate.
+*   @return value:  The number of blocks allocated, less than @n_blocks if
+*                   @fsa runs out of free blocks.
+*   @error: 		undefined behavior if @fsa or @blocks are invalid.
+*   @time complex: 	O(@n_blocks) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t FSAAllocBulk(fsa_t* fsa, void** blocks, size_t n_blocks);
+
+/* 
+*   @desc:          Frees the @n_blocks blocks of @blocks at once. They are
+*                   chained and attached to @fsa as one chain.
+*   @params: 	    @fsa: Pre-initialized FSA structure.
+*                   @blocks: array of @n_blocks pre-allocated blocks.
+*                   @n_blocks: the number of blocks to free.
+*   @return value:  None.
+*   @error: 		undefined behavior if @fsa or @blocks are invalid.
+*   @time complex: 	O(@n_blocks) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void FSAFreeBulk(fsa_t* fsa, void** blocks, size_t n_blocks);
+
 /* 
 *   @desc:          Returns the amount of free blocks currently contained 
 *                   within @fsa.
 *   @params: 	    @fsa: Pre-initialized FSA structure.
 *   @return value:  The number of free blocks.
 *   @error: 		undefined behavior if @fsa is invalid.
-*   @time complex: 	O(n) for both AC/WC
+*   @time complex: 	O(1) for both AC/WC
 *   @space complex: O(1) for both AC/WC
 */
 size_t FSACountFree(const fsa_t* fsa);
 
+/* 
+*   @desc:          Fills @stats with the counters of @fsa.
+*   @params: 	    @fsa: Pre-initialized FSA structure.
+*                   @stats: Pointer to the stats to fill.
+*   @return value:  None.
+*   @error: 		undefined behavior if @fsa or @stats are invalid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void FSAGetStats(const fsa_t* fsa, fsa_stats_t* stats);
+
 #endif  /* fsa.h */
\ No newline at end of file
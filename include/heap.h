@@ -22,7 +22,51 @@ heap_t* HeapCreate(compare_func_t compare_func);
 
 
 /*
-*	@desc:				Frees @heap using @HeapCreate
+*	@desc:				Allocates new d-ary heap based on @compare_func where
+*						every node has up to @arity children stored next to
+*						each other. The storage is 64 byte aligned and starts
+*						with @arity - 1 unused slots, so the children of a
+*						node start at a multiple of @arity slots; with 8 byte
+*						pointers an arity of 8 keeps them in exactly one 64
+*						byte cache line. The tree depth is cut by a factor of
+*						log2(@arity)
+*	@param:				@compare_func: compare function returns zero if equal, 
+*						negative if @data1 is less than @data2 and otherwise 
+*						postive
+*						@arity: number of children per node, must be at least 2
+*	@return:			Newly allocated heap
+*	@error:				Returns NULL if allocation failed
+*						Undefined behavior if @arity is less than 2
+*	@time complexity:	O(malloc) for both AC/WC
+*	@space complexity:	O(malloc) for both AC/WC
+*/
+heap_t* HeapCreateEx(compare_func_t compare_func, size_t arity);
+
+
+/*
+*	@desc:				Allocates new binary heap based on @compare_func which
+*						holds the @n_elements pointers of @array. The heap is
+*						built bottom-up in one pass instead of pushing the
+*						elements one by one
+*	@param:				@compare_func: compare function returns zero if equal, 
+*						negative if @data1 is less than @data2 and otherwise 
+*						postive
+*						@array: array of user data to insert, it is not
+*						modified
+*						@n_elements: number of elements in @array
+*	@return:			Newly allocated heap
+*	@error:				Returns NULL if allocation failed
+*						Undefined behavior if @array is invalid
+*	@time complexity:	O(n) for both AC/WC
+*	@space complexity:	O(n) for both AC/WC
+*/
+heap_t* HeapCreateFrom(compare_func_t compare_func, void** array,
+                                                            size_t n_elements);
+
+
+/*
+*	@desc:				Frees @heap using @HeapCreate, @HeapCreateEx or
+*						@HeapCreateFrom
 *	@param:				@heap: preallocated heap
 *	@return:			None
 *	@error:				Undefined behavior if @heap is invalid
@@ -45,6 +89,40 @@ void HeapDestroy(heap_t* heap);
 int HeapPush(heap_t* heap, void* data);
 
 
+/*
+*	@desc:				Moves all the elements of @src into @dst. @src is left
+*						empty and must still be destroyed by the user
+*	@param:				@dst: preallocated heap to merge into
+*						@src: preallocated heap with the same compare function
+*	@return:			Zero if function successful otherwise non zero
+*	@error:				Undefined behavior if @dst or @src are invalid or are
+*						the same heap
+*						Returns nonzero value if allocation failed, in which
+*						case both heaps are left unchanged
+*	@time complexity:	O(n + m) for both AC/WC
+*	@space complexity:	O(n + m) for both AC/WC
+*/
+int HeapMerge(heap_t* dst, heap_t* src);
+
+
+/*
+*	@desc:				Pushes the @n_elements pointers of @array to @heap. When
+*						the batch is larger than @heap the whole heap is rebuilt
+*						once instead of sifting up every new element
+*	@param:				@heap: preallocated heap
+*						@array: array of user data to insert, it is not
+*						modified
+*						@n_elements: number of elements in @array
+*	@return:			Zero if function successful otherwise non zero
+*	@error:				Undefined behavior if @heap or @array are invalid
+*						Returns nonzero value if allocation failed, in which
+*						case @heap is left unchanged
+*	@time complexity:	O(min(n + m, m * log(n))) AC and O(n + m) for WC
+*	@space complexity:	O(1) for AC and O(n + m) for WC
+*/
+int HeapPushMany(heap_t* heap, void** array, size_t n_elements);
+
+
 /*
 *	@desc:				Pops the first element from @heap
 *	@param:				@heap: preallocated heap
@@ -68,6 +146,18 @@ int HeapPop(heap_t* heap);
 void* HeapPeek(const heap_t* heap);
 
 
+/*
+*	@desc:				Removes all the elements from @heap, keeping its storage
+*						for later pushes
+*	@param:				@heap: preallocated heap
+*	@return:			None
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void HeapClear(heap_t* heap);
+
+
 /*
 *	@desc:				Returns the count of elements in @heap
 *	@param:				@heap: preallocated heap
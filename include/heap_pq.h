@@ -40,6 +40,21 @@ void PQDestroy(heap_pq_t* pq);
 */
 int PQEnqueue(heap_pq_t* pq, void* data);
 
+/* 
+*   @desc: 	        Enqueues the @n_elements items of @data to @pq. Large
+*					batches are heapified once instead of one by one.
+*   @params: 	    @pq : pre allocated priority queue.
+*				    @data: array of the data of the new elements
+*					@n_elements: number of elements in @data
+*   @return value: 	returns 0 on success
+*   @error: 		In the event insertion fails(due to allocation) will return
+* 				    non zero value and @pq is left unchanged.
+*					Undefined Behavior if @pq or @data are not valid.
+*   @time complex: 	O(min(n + m, m * log(n))) AC and O(n + m) for WC
+*   @space complex: O(1) AC and O(n + m) for WC
+*/
+int PQEnqueueMany(heap_pq_t* pq, void** data, size_t n_elements);
+
 /*
 *   @desc:		   	Removes the first element from @pq.
 *   @params: 	   	@pq : pre allocated priority queue.
@@ -50,6 +65,20 @@ int PQEnqueue(heap_pq_t* pq, void* data);
 */
 void* PQDequeue(heap_pq_t* pq);
 
+/*
+*   @desc:		   	Removes up to @k first elements from @pq and writes them to
+*					@out in priority order.
+*   @params: 	   	@pq : pre allocated priority queue.
+*					@out: array with room for at least @k elements.
+*					@k: maximal number of elements to remove.
+*   @return value: 	Returns the number of elements removed, which is less than
+*					@k if @pq had fewer elements.
+*   @error: 	   	Undefined Behavior if @pq or @out are invalid.
+*   @time complex: 	O(k * log(n)) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+size_t PQDequeueMany(heap_pq_t* pq, void** out, size_t k);
+
 /* 
 *   @desc: 		   	Returns the data of the first element in @pq.
 *   @params: 	   	@pq : pre allocated priority queue.
@@ -85,7 +114,7 @@ size_t PQSize(const heap_pq_t* pq);
 *   @params: 		@pq : pre allocated priority queue.
 *   @return value: 	None
 *   @error: 		Undefined behavior if @pq is invalid.
-*   @time complex: 	O(n) for both AC/WC.
+*   @time complex: 	O(1) for both AC/WC.
 *   @space complex: O(1) for both AC/WC.
 */
 void PQClear(heap_pq_t* pq);
@@ -101,4 +130,23 @@ void PQClear(heap_pq_t* pq);
 */
 void* PQErase(heap_pq_t* pq, int (*is_match)(const void*, const void*), const void* param);
 
+/*
+*   @desc:          Finds the @k first elements of @array by the priority of
+*					@compare_func without a priority queue. @array is not
+*					modified.
+*   @params:        @array: array of user data.
+*					@n_elements: number of elements in @array.
+*					@k: number of elements to find.
+*					@compare_func: Compare function that the priority is sorted
+*					by.
+*	@return value:	Newly allocated array of min(@k, @n_elements) elements in
+*					priority order. Must be freed by the user.
+*	@error:			NULL if allocation fails.
+*					Undefined behavior if @array or @compare_func are invalid.
+*	@time complex:	O(n + k * log(n)) for both AC/WC.
+*	@space complex:	O(n) for both AC/WC.
+*/
+void** PQTopK(void** array, size_t n_elements, size_t k,
+                                int (*compare_func)(const void*, const void*));
+
 #endif  /* __PQ_HEAP_H__ */
@@ -0,0 +1,147 @@
+#ifndef __INTERVAL_TREE_H__
+#define __INTERVAL_TREE_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   Interval tree. An AVL sorted by the low endpoints, where every node also
+*   keeps the highest endpoint of its subtree, fixed along every rotation.
+*   Overlap queries only visit the subtrees that may hold an overlapping
+*   interval. Intervals are closed, [low, high].
+*/
+typedef struct interval_tree interval_tree_t;
+typedef struct it_node it_node_t;
+typedef int (*action_func_t)(void* ,void* );
+
+/*
+*   @desc:          Allocates a new empty interval tree. Must be destroyed
+*                   with @ITDestroy
+*   @params: 	    None
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+interval_tree_t* ITCreate(void);
+
+/*
+*   @desc:          Frees @tree. Must have been created using @ITCreate
+*   @params: 	    @tree: tree to free
+*   @return value:  None
+*   @error: 		Undefined behavior if @tree is not valid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+void ITDestroy(interval_tree_t* tree);
+
+/*
+*   @desc:          Inserts the interval [@low, @high] holding @data. The
+*                   same interval may be inserted more than once.
+*   @params: 	    @tree: valid tree
+*                   @low: low endpoint
+*                   @high: high endpoint, not less than @low
+*                   @data: user data of the interval
+*   @return value:  Handle of the new interval, valid until it is removed
+*   @error: 		NULL if allocation fails
+*                   Undefined behaviour if @tree is invalid or @high is less
+*                   than @low
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+it_node_t* ITInsert(interval_tree_t* tree, long low, long high, void* data);
+
+/*
+*   @desc:          Removes the interval of @node from @tree
+*   @params: 	    @tree: valid tree
+*                   @node: handle returned by @ITInsert
+*   @return value:  The data of the removed interval
+*   @error: 		Undefined behaviour if @tree or @node are invalid
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* ITRemove(interval_tree_t* tree, it_node_t* node);
+
+/*
+*   @desc:          Finds an interval of @tree which overlaps [@low, @high]
+*   @params:	    @tree: valid tree
+*                   @low: low endpoint of the query
+*                   @high: high endpoint of the query
+*   @return value:  Handle of an overlapping interval or NULL if none
+*                   overlaps
+*   @error:		    undefined behavior if @tree is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+it_node_t* ITFindAny(const interval_tree_t* tree, long low, long high);
+
+/*
+*   @desc:          Performs @action_func with @param on the data of every
+*                   interval which overlaps [@low, @high], in ascending order
+*                   of the low endpoints. Stops once @action_func fails.
+*                   @action_func must not change @tree.
+*   @params:	    @tree: valid tree
+*                   @low: low endpoint of the query
+*                   @high: high endpoint of the query
+*                   @action_func: function to perform, returns 0 on success
+*                   @param: param for @action_func
+*   @return value:  0 if @action_func succeeded for all of the overlapping
+*                   intervals, otherwise the value @action_func failed with.
+*   @error:		    undefined behavior if @tree or @action_func are invalid
+*   @time complex:  O(log(n) + k) * O(@action_func), k is the number of
+*                   overlapping intervals
+*   @space complex: O(log(n)) + O(@action_func)
+*/
+int ITForEachOverlap(const interval_tree_t* tree, long low, long high,
+                                    action_func_t action_func, void* param);
+
+/*
+*   @desc:          Returns the data of the interval of @node
+*   @params:        @node: valid handle
+*   @return value:  The data of the interval
+*   @error:         Undefined behavior if @node is invalid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+void* ITGetData(const it_node_t* node);
+
+/*
+*   @desc:          Returns the low endpoint of the interval of @node
+*   @params:        @node: valid handle
+*   @return value:  The low endpoint
+*   @error:         Undefined behavior if @node is invalid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+long ITGetLow(const it_node_t* node);
+
+/*
+*   @desc:          Returns the high endpoint of the interval of @node
+*   @params:        @node: valid handle
+*   @return value:  The high endpoint
+*   @error:         Undefined behavior if @node is invalid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+long ITGetHigh(const it_node_t* node);
+
+/*
+*   @desc:          Returns the number of intervals in @tree
+*   @params:        @tree: valid tree
+*   @return value:  Number of intervals in @tree
+*   @error:         Undefined beahvior if @tree is invalid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t ITGetSize(const interval_tree_t* tree);
+
+/*
+*   @desc:          Checks if @tree is empty.
+*   @params: 	    @tree: valid tree
+*   @return value:  Return one if @tree is empty and zero otherwise.
+*   @error: 		Undefined behavior if @tree is not valid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+int ITIsEmpty(const interval_tree_t* tree);
+
+#endif      /* __INTERVAL_TREE_H__ */
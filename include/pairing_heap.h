@@ -0,0 +1,135 @@
+#ifndef __PAIRING_HEAP_H__
+#define __PAIRING_HEAP_H__
+
+#include <stddef.h> /* size_t */
+
+typedef struct pairing_heap pairing_heap_t;
+typedef struct ph_node ph_node_t;
+typedef int (*compare_func_t)(const void* data, const void* param);
+
+
+/*
+*	@desc:				Allocates new pairing heap based on @compare_func
+*	@param:				@compare_func: compare function returns zero if equal,
+*						negative if @data1 is less than @data2 and otherwise
+*						postive
+*	@return:			Newly allocated pairing heap
+*	@error:				Returns NULL if allocation failed
+*	@time complexity:	O(malloc) for both AC/WC
+*	@space complexity:	O(malloc) for both AC/WC
+*/
+pairing_heap_t* PairingHeapCreate(compare_func_t compare_func);
+
+
+/*
+*	@desc:				Frees @heap using @PairingHeapCreate
+*	@param:				@heap: preallocated pairing heap
+*	@return:			None
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(n) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void PairingHeapDestroy(pairing_heap_t* heap);
+
+
+/*
+*	@desc:				Pushes @data to @heap
+*	@param:				@heap: preallocated pairing heap
+*						@data: user data to insert
+*	@return:			Handle of the new element, valid until it is popped or
+*						removed
+*	@error:				Undefined behavior if @heap is invalid
+*						Returns NULL if allocation failed
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+ph_node_t* PairingHeapPush(pairing_heap_t* heap, void* data);
+
+
+/*
+*	@desc:				Pops the first element from @heap
+*	@param:				@heap: preallocated pairing heap
+*	@return:			The data of the popped element
+*	@error:				Undefined behavior if @heap is invalid or @heap is empty
+*	@time complexity:	O(log(n)) amortized AC and O(n) for WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void* PairingHeapPop(pairing_heap_t* heap);
+
+
+/*
+*	@desc:				Returns the first element from @heap
+*	@param:				@heap: preallocated pairing heap
+*	@return:			First element data
+*	@error:				Undefined behavior if @heap is invalid or @heap is empty
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void* PairingHeapPeek(const pairing_heap_t* heap);
+
+
+/*
+*	@desc:				Replaces the data of @node with @data which must not
+*						compare greater than the current data of @node
+*	@param:				@heap: preallocated pairing heap
+*						@node: handle of an element of @heap
+*						@data: new user data of @node
+*	@return:			None
+*	@error:				Undefined behavior if @heap or @node are invalid or
+*						@data compares greater than the data of @node
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void PairingHeapDecreaseKey(pairing_heap_t* heap, ph_node_t* node, void* data);
+
+
+/*
+*	@desc:				Removes @node from @heap
+*	@param:				@heap: preallocated pairing heap
+*						@node: handle of an element of @heap
+*	@return:			Returns the data of the removed element
+*	@error:				Undefined behavior if @heap or @node are invalid
+*	@time complexity:	O(log(n)) amortized AC and O(n) for WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void* PairingHeapRemove(pairing_heap_t* heap, ph_node_t* node);
+
+
+/*
+*	@desc:				Moves all the elements of @src into @dst. @src is left
+*						empty and must still be destroyed by the user. Handles
+*						of @src elements stay valid and now belong to @dst
+*	@param:				@dst: preallocated pairing heap to merge into
+*						@src: preallocated pairing heap with the same compare
+*						function
+*	@return:			None
+*	@error:				Undefined behavior if @dst or @src are invalid or are
+*						the same heap
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void PairingHeapMerge(pairing_heap_t* dst, pairing_heap_t* src);
+
+
+/*
+*	@desc:				Returns the count of elements in @heap
+*	@param:				@heap: preallocated pairing heap
+*	@return:			Returns the count of elements in @heap
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+size_t PairingHeapSize(const pairing_heap_t* heap);
+
+
+/*
+*	@desc:				Checks if @heap is empty
+*	@param:				@heap: preallocated pairing heap
+*	@return:			Returns one if @heap is empty otherwise zero
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+int PairingHeapIsEmpty(const pairing_heap_t* heap);
+
+#endif /* __PAIRING_HEAP_H__ */
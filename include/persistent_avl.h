@@ -0,0 +1,186 @@
+#ifndef __PERSISTENT_AVL_H__
+#define __PERSISTENT_AVL_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   Persistent AVL. A version is never changed once created, insert and remove
+*   copy the O(log(n)) nodes on the path they change and return a new version
+*   that shares every other node with the old one. Any number of threads may
+*   search a version they hold without locking.
+*   Versions and nodes are reference counted, a node is freed once no version
+*   reaches it anymore. With GCC the counts are updated atomically, so
+*   versions may be acquired and destroyed from any thread.
+*   @pavl_root_t publishes the latest version to readers, its operations hold
+*   a mutex only for the pointer handoff. Built on POSIX threads, link with
+*   -pthread.
+*/
+typedef struct pavl pavl_t;
+typedef struct pavl_root pavl_root_t;
+typedef int (*compare_func_t)(const void* data, const void* param);
+typedef int (*action_func_t)(void* ,void* );
+
+/*
+*   @desc:          Allocates a new empty version which is sorted by
+*                   @compare_func. Must be destroyed with @PAVLDestroy
+*   @params: 	    @compare_func: compare function that the tree is sorted by
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails
+*                   Undefined behavior if @compare_func is invalid
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+pavl_t* PAVLCreate(compare_func_t compare_func);
+
+/*
+*   @desc:          Releases a reference to @version, which is freed along
+*                   with the nodes only it reaches once the last reference is
+*                   released. Thread safe.
+*   @params: 	    @version: version to release
+*   @return value:  None
+*   @error: 		Undefined behavior if @version is not valid
+*   @time complex: 	O(1) AC and O(n) for WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+void PAVLDestroy(pavl_t* version);
+
+/*
+*   @desc:          Takes another reference to @version, which must be
+*                   released with @PAVLDestroy. Thread safe.
+*   @params: 	    @version: valid version
+*   @return value:  @version
+*   @error: 		Undefined behavior if @version is not valid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+pavl_t* PAVLAcquire(pavl_t* version);
+
+/*
+*   @desc:          Returns a new version which holds the elements of
+*                   @version and @data. @version is not changed.
+*   @params: 	    @version: valid version
+*                   @data: data to insert, must not already be in @version
+*   @return value:  The new version, must be destroyed with @PAVLDestroy
+*   @error: 		NULL if allocation fails
+*                   Undefined behaviour if @version is invalid
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+pavl_t* PAVLInsert(const pavl_t* version, const void* data);
+
+/*
+*   @desc:          Returns a new version which holds the elements of
+*                   @version except for the one matching @param. @version is
+*                   not changed.
+*   @params: 	    @version: valid version
+*                   @param: param to remove
+*   @return value:  The new version, must be destroyed with @PAVLDestroy.
+*                   If no element matches @param it shares all of the nodes
+*                   of @version
+*   @error: 		NULL if allocation fails
+*                   Undefined behaviour if @version is invalid
+*   @time complex: 	O(log(n)) for both AC/WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+pavl_t* PAVLRemove(const pavl_t* version, const void* param);
+
+/*
+*   @desc:          Finds @param in @version. Takes no lock.
+*   @params:	    @version: valid version
+*                   @param: param to find
+*   @return value:  returns the data of the found element or NULL if not
+*                   found.
+*   @error:		    undefined behavior if @version is invalid
+*   @time complex:  O(log(n)) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void* PAVLFind(const pavl_t* version, const void* param);
+
+/*
+*   @desc:          Performs @action_func with @param on every element of
+*                   @version in order. Stops once @action_func fails.
+*   @params:        @version: valid version
+*                   @action_func: function to perform, returns 0 on success
+*                   @param: param for @action_func
+*   @return value:  0 if @action_func succeeded for all of the elements,
+*                   otherwise the value @action_func failed with.
+*   @error:         Undefined behavior if @version or @action_func are
+*                   invalid.
+*   @time complex: 	O(n) * O(@action_func)
+*   @space complex: O(log(n)) + O(@action_func)
+*/
+int PAVLForEach(const pavl_t* version, action_func_t action_func,
+                                                                void* param);
+
+/*
+*   @desc:          Returns the number of elements in @version
+*   @params:        @version: valid version
+*   @return value:  Number of elements in @version
+*   @error:         Undefined beahvior if @version is invalid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+size_t PAVLGetSize(const pavl_t* version);
+
+/*
+*   @desc:          Checks if @version is empty.
+*   @params: 	    @version: valid version
+*   @return value:  Return one if @version is empty and zero otherwise.
+*   @error: 		Undefined behavior if @version is not valid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+int PAVLIsEmpty(const pavl_t* version);
+
+/*
+*   @desc:          Allocates a root which publishes @version. The root takes
+*                   over the caller's reference to @version. Must be
+*                   destroyed with @PAVLRootDestroy
+*   @params: 	    @version: valid version
+*   @return value:  Pointer to the allocation
+*   @error: 		NULL if allocation fails, in which case the caller still
+*                   owns its reference to @version
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+pavl_root_t* PAVLRootCreate(pavl_t* version);
+
+/*
+*   @desc:          Frees @root and releases the version it publishes. No
+*                   other thread may use @root anymore.
+*   @params: 	    @root: root to free
+*   @return value:  None
+*   @error: 		Undefined behavior if @root is not valid
+*   @time complex: 	O(1) AC and O(n) for WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+void PAVLRootDestroy(pavl_root_t* root);
+
+/*
+*   @desc:          Returns the version @root currently publishes. The snapshot
+*                   stays valid until it is destroyed, whatever is stored
+*                   to @root meanwhile. Thread safe.
+*   @params: 	    @root: valid root
+*   @return value:  Acquired version, must be destroyed with @PAVLDestroy
+*   @error: 		Undefined behavior if @root is not valid
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+pavl_t* PAVLRootLoad(pavl_root_t* root);
+
+/*
+*   @desc:          Publishes @version in @root and releases the version it
+*                   replaces. @root takes over the caller's reference to
+*                   @version. Thread safe, but writers that load, modify and
+*                   store must be serialized by the caller so no update is
+*                   lost.
+*   @params: 	    @root: valid root
+*                   @version: version to publish
+*   @return value:  None
+*   @error: 		Undefined behavior if @root or @version are not valid
+*   @time complex: 	O(1) AC and O(n) for WC
+*   @space complex: O(log(n)) for both AC/WC
+*/
+void PAVLRootStore(pavl_root_t* root, pavl_t* version);
+
+#endif      /* __PERSISTENT_AVL_H__ */
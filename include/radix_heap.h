@@ -0,0 +1,97 @@
+#ifndef __RADIX_HEAP_H__
+#define __RADIX_HEAP_H__
+
+#include <stddef.h> /* size_t */
+
+typedef struct radix_heap radix_heap_t;
+
+
+/*
+*	@desc:				Allocates new radix heap. A radix heap is a monotone
+*						priority queue of unsigned keys: a pushed key must not
+*						be smaller than the key of the last popped element
+*	@param:				None
+*	@return:			Newly allocated radix heap
+*	@error:				Returns NULL if allocation failed
+*	@time complexity:	O(malloc) for both AC/WC
+*	@space complexity:	O(malloc) for both AC/WC
+*/
+radix_heap_t* RadixHeapCreate(void);
+
+
+/*
+*	@desc:				Frees @heap using @RadixHeapCreate
+*	@param:				@heap: preallocated radix heap
+*	@return:			None
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(n) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void RadixHeapDestroy(radix_heap_t* heap);
+
+
+/*
+*	@desc:				Pushes @data with priority @key to @heap
+*	@param:				@heap: preallocated radix heap
+*						@key: priority of @data, smaller keys are popped first
+*						@data: user data to insert
+*	@return:			Zero if function successful otherwise non zero
+*	@error:				Undefined behavior if @heap is invalid or @key is
+*						smaller than the last popped key
+*						Returns nonzero value if allocation failed
+*	@time complexity:	O(log(C)) for both AC/WC, C is the key range
+*	@space complexity:	O(1) for both AC/WC
+*/
+int RadixHeapPush(radix_heap_t* heap, size_t key, void* data);
+
+
+/*
+*	@desc:				Pops the element with the smallest key from @heap
+*	@param:				@heap: preallocated radix heap
+*						@key: if not NULL, receives the key of the popped
+*						element
+*	@return:			The data of the popped element
+*	@error:				Undefined behavior if @heap is invalid or @heap is empty
+*	@time complexity:	O(log(C)) amortized AC and O(n) for WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+void* RadixHeapPop(radix_heap_t* heap, size_t* key);
+
+
+/*
+*	@desc:				Returns the element with the smallest key in @heap
+*						without removing it. Keys smaller than it may still
+*						be pushed until it is popped
+*	@param:				@heap: preallocated radix heap
+*						@key: if not NULL, receives the key of the element
+*	@return:			The data of the first element
+*	@error:				Undefined behavior if @heap is invalid or @heap is empty
+*	@time complexity:	O(log(C) + k) for both AC/WC, k is the number of
+*						elements in the lowest bucket in use
+*	@space complexity:	O(1) for both AC/WC
+*/
+void* RadixHeapPeek(const radix_heap_t* heap, size_t* key);
+
+
+/*
+*	@desc:				Returns the count of elements in @heap
+*	@param:				@heap: preallocated radix heap
+*	@return:			Returns the count of elements in @heap
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+size_t RadixHeapSize(const radix_heap_t* heap);
+
+
+/*
+*	@desc:				Checks if @heap is empty
+*	@param:				@heap: preallocated radix heap
+*	@return:			Returns one if @heap is empty otherwise zero
+*	@error:				Undefined behavior if @heap is invalid
+*	@time complexity:	O(1) for both AC/WC
+*	@space complexity:	O(1) for both AC/WC
+*/
+int RadixHeapIsEmpty(const radix_heap_t* heap);
+
+#endif /* __RADIX_HEAP_H__ */
@@ -0,0 +1,59 @@
+#ifndef __SLAB_H__
+#define __SLAB_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   Slab allocator. Sizes up to @SLAB_MAX_SIZE are routed to size classes
+*   growing by halves of powers of two, 16, 24, 32, 48 and so on, each class
+*   serves its blocks from pages of a fixed size allocator. The pages are cut
+*   from one memory pool, a page which empties goes back to the pool and may
+*   be taken by any class.
+*   Uses Fixed Size Allocator for the pages.
+*/
+typedef struct slab slab_t;
+
+#define SLAB_MAX_SIZE (4096)
+
+/*
+*   @desc:          Initializes a slab allocator in a memory pool. Pages are
+*                   prepared on demand.
+*   @params:        @memory: Pointer to the start of the preallocated memory
+*                   block.
+*				    @memory_size : Total memory size in bytes.
+*   @return value:  Pointer to the slab structure, and returns NULL if
+*                   @memory_size is not big enough for the structure and a
+*                   single page.
+*   @error: 		Undefined behavior if @memory is invalid and
+*                   allocated less memory than @memory_size.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+slab_t* SlabInit(void* memory, size_t memory_size);
+
+/*
+*   @desc:          Returns the pointer to a new allocated block of the
+*                   smallest size class which holds @alloc_size bytes.
+*   @params: 	    @slab: pointer to pre-initialized @slab.
+*                   @alloc_size: size to allocate.
+*   @return value:  Returns NULL if no page is available for the class, if
+*                   @alloc_size is 0 or bigger than @SLAB_MAX_SIZE
+*   @error: 		Undefined behavior if @slab is invalid.
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+void* SlabAlloc(slab_t* slab, size_t alloc_size);
+
+/*
+*   @desc:          Frees a pre-allocated memory block. if @block is NULL
+*                   no operation will be performed.
+*   @params: 	    @slab: pointer to the @slab @block was allocated from.
+*                   @block: Pointer to pre-allocated block
+*   @return value:  None
+*   @error: 		Undefined behavior if @slab or @block are incorrect
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+void SlabFree(slab_t* slab, void* block);
+
+#endif      /* __SLAB_H__ */
@@ -0,0 +1,107 @@
+#ifndef __TIMING_WHEEL_H__
+#define __TIMING_WHEEL_H__
+
+#include <stddef.h>		/* size_t */
+
+typedef struct timing_wheel timing_wheel_t;
+typedef struct tw_timer tw_timer_t;
+typedef void (*expire_func_t)(void* data, void* param);
+
+/*
+*   @desc:          Allocates a hierarchical timing wheel whose clock starts at
+*					tick zero. Must be destroyed with @TWDestroy
+*   @params: 		None
+*   @return value:  Pointer to the allocated timing wheel
+*   @error: 		NULL if allocation fails
+*   @time complex: 	O(malloc) for both AC/WC
+*   @space complex: O(malloc) for both AC/WC
+*/
+timing_wheel_t* TWCreate(void);
+
+/*
+*   @desc: 	        Frees @wheel and all of its pending timers without expiring
+*					them. Must be created using @TWCreate.
+*   @params: 	    @wheel: timing wheel to free.
+*   @return value: 	None
+*   @error: 		Undefined behavior if @wheel is not valid
+*   @time complex: 	O(n) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+void TWDestroy(timing_wheel_t* wheel);
+
+/*
+*   @desc: 	        Arms a timer that expires with @data @delay ticks from the
+*					current tick of @wheel. A @delay of zero is treated as one.
+*   @params: 	    @wheel: pre allocated timing wheel.
+*				    @delay: number of ticks until the timer expires
+*				    @data: user data passed to the expire function
+*   @return value: 	Handle of the new timer, valid until it expires or is
+*					cancelled.
+*   @error: 		NULL if allocation fails.
+*					Undefined Behavior if @wheel is not valid.
+*   @time complex: 	O(1) for both AC/WC
+*   @space complex: O(1) for both AC/WC
+*/
+tw_timer_t* TWSchedule(timing_wheel_t* wheel, size_t delay, void* data);
+
+/*
+*   @desc:		   	Disarms @timer without expiring it.
+*   @params: 	   	@wheel: pre allocated timing wheel.
+*					@timer: pending timer of @wheel.
+*   @return value: 	Returns the data of the cancelled timer
+*   @error: 	   	Undefined Behavior if @wheel is invalid or @timer has
+*					already expired or been cancelled.
+*   @time complex: 	O(1) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+void* TWCancel(timing_wheel_t* wheel, tw_timer_t* timer);
+
+/*
+*   @desc:		   	Moves the clock of @wheel @ticks ticks forward and calls
+*					@expire_func with the data of every timer that became due,
+*					in expiration order. @expire_func may schedule and cancel
+*					other timers, but the timer being expired is no longer
+*					valid.
+*   @params: 	   	@wheel: pre allocated timing wheel.
+*					@ticks: number of ticks to advance.
+*					@expire_func: function called for every due timer.
+*					@param: user parameter passed to @expire_func.
+*   @return value: 	Returns the number of expired timers.
+*   @error: 	   	Undefined Behavior if @wheel or @expire_func are invalid.
+*   @time complex: 	O(ticks + k) AC amortized, O(ticks + n) for WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+size_t TWAdvance(timing_wheel_t* wheel, size_t ticks, expire_func_t expire_func,
+                                                                void* param);
+
+/*
+*   @desc: 		   	Returns the current tick of @wheel.
+*   @params: 	   	@wheel: pre allocated timing wheel.
+*   @return value: 	The current tick.
+*   @error: 	   	Undefined behavior if @wheel is invalid.
+*   @time complex: 	O(1) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+size_t TWGetTime(const timing_wheel_t* wheel);
+
+/*
+*   @desc: 	        Returns the number of pending timers in @wheel
+*   @params: 		@wheel: pre allocated timing wheel.
+*   @return value: 	Number of pending timers.
+*   @error: 		Undefined behavior if @wheel is invalid.
+*   @time complex: 	O(1) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+size_t TWSize(const timing_wheel_t* wheel);
+
+/*
+*   @desc: 		   	Checks if @wheel has no pending timers.
+*   @params: 	   	@wheel: pre allocated timing wheel.
+*   @return value: 	1 if @wheel is empty 0 otherwise.
+*   @error: 	   	Undefined behavior if @wheel is invalid.
+*   @time complex: 	O(1) for both AC/WC.
+*   @space complex: O(1) for both AC/WC.
+*/
+int TWIsEmpty(const timing_wheel_t* wheel);
+
+#endif  /* __TIMING_WHEEL_H__ */
@@ -5,6 +5,15 @@
 
 typedef struct vsa vsa_t;
 
+typedef struct vsa_stats
+{
+    size_t bytes_in_use;        /* allocated bytes, rounded up to words */
+    size_t peak_bytes_in_use;   /* most bytes in use at once */
+    size_t blocks_in_use;
+    size_t bytes_free;          /* free bytes, not counting block headers */
+    size_t free_blocks;
+} vsa_stats_t;
+
 /* 
 *   @desc:          Initializes a memory pool for VSA. The memory pool's blocks 
 *                   can be allocated and freed individually.
@@ -19,17 +28,77 @@ typedef struct vsa vsa_t;
 */
 vsa_t* VSAInit(void* memory, size_t memory_size);
 
+/* 
+*   @desc:          Reserves @max_size bytes of address space for a VSA
+*                   without backing memory. Pages are committed as
+*                   @VSAAlloc needs them, and can be given back to the system
+*                   with @VSATrim. Must be destroyed with @VSADestroy.
+*   @params:        @max_size: the most bytes the pool can grow to
+*   @return value:  Pointer to the VSA structure
+*   @error: 		NULL if the address space can not be reserved or
+*                   @max_size is less than a page
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+vsa_t* VSACreateGrowable(size_t max_size);
+
+/* 
+*   @desc:          Gives the whole range of @vsa back to the system. Every
+*                   block of @vsa is freed.
+*   @params:        @vsa: VSA created by @VSACreateGrowable
+*   @return value:  None
+*   @error: 		Undefined behavior if @vsa was not created by
+*                   @VSACreateGrowable
+*   @time complex: 	O(1)
+*   @space complex: O(1)
+*/
+void VSADestroy(vsa_t* vsa);
+
 /* 
 *   @desc:          Returns the pointer to the new allocated block.
 *   @params: 	    @vsa: pointer to pre-initialized @vsa.
                     @alloc_size: size to allocate.
 *   @return value:  Returns NULL if no free space available or if @alloc_size is 0
+*                   A pool of @VSACreateGrowable commits more pages before it
+*                   fails.
 *   @error: 		Undefined behavior if @vsa is invalid.
 *   @time complex: 	O(n)
 *   @space complex: O(1)
 */
 void* VSAAlloc(vsa_t* vsa, size_t alloc_size);
 
+/* 
+*   @desc:          Returns the pointer to a new allocated block, which starts
+*                   at an address aligned to @align.
+*   @params: 	    @vsa: pointer to pre-initialized @vsa.
+*                   @alloc_size: size to allocate.
+*                   @align: alignment in bytes, a power of two.
+*   @return value:  Returns NULL if no free space available or if @alloc_size
+*                   is 0
+*   @error: 		Undefined behavior if @vsa is invalid or @align is not a
+*                   power of two.
+*   @time complex: 	O(n)
+*   @space complex: O(1)
+*/
+void* VSAAllocAligned(vsa_t* vsa, size_t alloc_size, size_t align);
+
+/* 
+*   @desc:          Resizes @block to @new_size, keeping its content. The
+*                   block grows in place into a free block right after it,
+*                   otherwise it is moved to a new block. If @block is NULL
+*                   acts as @VSAAlloc, if @new_size is 0 acts as @VSAFree.
+*   @params: 	    @vsa: pointer to pre-initialized @vsa @block belongs to.
+*                   @block: Pointer to pre-allocated block or NULL
+*                   @new_size: size of the block after the call.
+*   @return value:  Pointer to the resized block, NULL if no free space is
+*                   available, and then @block is left as is. A moved block
+*                   keeps the alignment of @VSAAlloc only.
+*   @error: 		Undefined behavior if @vsa or @block are invalid.
+*   @time complex: 	O(n)
+*   @space complex: O(1)
+*/
+void* VSARealloc(vsa_t* vsa, void* block, size_t new_size);
+
 /* 
 *   @desc:          Frees a pre-allocated memory block. if @block is NULL
 *                   no operation will be performed.
@@ -51,4 +120,56 @@ void VSAFree(void* block);
 */
 size_t VSALargestChunkAvailable(vsa_t* vsa);
 
+/* 
+*   @desc:          Gives the pages after the last allocated block back to
+*                   the system. They are committed again on demand. No
+*                   operation is performed for a pool of @VSAInit.
+*   @params:        @vsa: Pointer to the initialized @vsa.
+*   @return value:  Number of bytes given back.
+*   @error:         Undefined behavior if @vsa is invalid.
+*   @time complex:  O(n)
+*   @space complex: O(1)
+*/
+size_t VSATrim(vsa_t* vsa);
+
+/* 
+*   @desc:          Fills @stats with the counters of @vsa. Free blocks next
+*                   to each other are counted apart until an allocation walks
+*                   over them and merges them.
+*   @params:        @vsa: Pointer to the initialized @vsa.
+*                   @stats: Pointer to the stats to fill.
+*   @return value:  None
+*   @error:         Undefined behavior if @vsa or @stats are invalid.
+*   @time complex:  O(1)
+*   @space complex: O(1)
+*/
+void VSAGetStats(const vsa_t* vsa, vsa_stats_t* stats);
+
+/* 
+*   @desc:          Counts the blocks of @vsa by size. Bucket i counts the
+*                   blocks of 2^i up to 2^(i+1) - 1 bytes, the last bucket
+*                   also counts all of the bigger blocks. Free blocks next to
+*                   each other are merged first. The same walk reports the
+*                   largest free block and the free bytes, from which the
+*                   external fragmentation is 1 - largest / free bytes.
+*   @params:        @vsa: Pointer to the initialized @vsa.
+*                   @used_histogram: @n_buckets counters for the allocated
+*                   blocks, or NULL
+*                   @free_histogram: @n_buckets counters for the free blocks,
+*                   or NULL
+*                   @n_buckets: number of buckets, at least 1
+*                   @largest_free: receives the size of the largest free
+*                   block in bytes, or NULL
+*                   @bytes_free: receives the size of all the free blocks in
+*                   bytes, or NULL
+*   @return value:  None
+*   @error:         Undefined behavior if @vsa is invalid or the histograms
+*                   are shorter than @n_buckets.
+*   @time complex:  O(n)
+*   @space complex: O(1)
+*/
+void VSAGetHistogram(vsa_t* vsa, size_t* used_histogram,
+                                    size_t* free_histogram, size_t n_buckets,
+                                    size_t* largest_free, size_t* bytes_free);
+
 #endif      /* __VSA_H__ */                            
\ No newline at end of file
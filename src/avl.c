@@ -2,24 +2,51 @@
 #include <stdlib.h>      /*malloc, free*/
 
 #include "avl.h"
+#include "fsa.h"
 
-#define MAX(a,b) (a > b ? a : b)
+/*
+*   nodes of @AVLCreateFromSorted share one allocation, which is freed when its
+*   last node is freed
+*/
+typedef struct node_block {
+    size_t n_live;
+} node_block_t;
 
-typedef struct avl_node {
+struct avl_node {
     void* data;
     struct avl_node* left;
     struct avl_node* right;
+    struct avl_node* parent;
     size_t height;
-} avl_node_t;
+    size_t size;
+    node_block_t* block;
+};
 
+/* the root of the tree is the left child of @dummy, which is the end iter */
 struct avl {
     compare_func_t compare_func;
-    avl_node_t* root;
+    avl_node_t dummy;
+    fsa_t* fsa;         /* node storage of @AVLCreateInMemory, else NULL */
 };
 
+static avl_iter_t NodeToIter(avl_node_t* node)
+{
+    avl_iter_t iter;
+
+    iter.node = node;
+
+    return iter;
+}
+
+static avl_node_t* GetRoot(const avl_t* avl)
+{
+    return avl->dummy.left;
+}
+
 avl_t* AVLCreate(compare_func_t compare_func)
 {
     avl_t* avl = NULL;
+    avl_node_t dummy = {0};
 
     assert(compare_func);
 
@@ -31,139 +58,391 @@ avl_t* AVLCreate(compare_func_t compare_func)
     }
 
     avl->compare_func = compare_func;
-    avl->root = NULL;
+    avl->dummy = dummy;
+    avl->fsa = NULL;
 
     return avl;
 }
 
-static void DestroyNodes(avl_node_t* node)
+static void FreeNode(avl_t* avl, avl_node_t* node)
+{
+    if(avl->fsa)
+    {
+        FSAFree(avl->fsa, node);
+    }
+
+    else if(!node->block)
+    {
+        free(node);
+    }
+
+    else if(--node->block->n_live == 0)
+    {
+        free(node->block);
+    }
+}
+
+static void DestroyNodes(avl_t* avl, avl_node_t* node)
 {
     if(!node)
     {
         return;
     }
 
-    DestroyNodes(node->left);
-    DestroyNodes(node->right);
-    free(node);
+    DestroyNodes(avl, node->left);
+    DestroyNodes(avl, node->right);
+    FreeNode(avl, node);
 }
 
+/* nodes in a caller's memory are not given back, it is reused as a whole */
 void AVLDestroy(avl_t* avl)
 {
     assert(avl);
 
-    DestroyNodes(avl->root);
+    if(!avl->fsa)
+    {
+        DestroyNodes(avl, GetRoot(avl));
+    }
+
     free(avl);
 }
 
-static void UpdateHeight(avl_node_t* node)
+size_t AVLSuggestSize(size_t n_elements)
+{
+    return FSASuggestSize(sizeof(avl_node_t), n_elements);
+}
+
+avl_t* AVLCreateInMemory(compare_func_t compare_func, void* memory,
+                                                        size_t memory_size)
 {
-    size_t left_height = node->left ? node->left->height : 0;
-    size_t right_height = node->right ? node->right->height : 0;
+    avl_t* avl = NULL;
+    fsa_t* fsa = NULL;
+
+    assert(compare_func);
+    assert(memory);
+
+    fsa = FSAInit(memory, sizeof(avl_node_t), memory_size);
+
+    if(!fsa)
+    {
+        return NULL;
+    }
+
+    avl = AVLCreate(compare_func);
+
+    if(avl)
+    {
+        avl->fsa = fsa;
+    }
 
-    node->height = (node->left || node->right) + MAX(left_height, right_height);
+    return avl;
 }
 
-static avl_node_t* RotateLeft(avl_node_t* root)
+static size_t GetSubtreeSize(const avl_node_t* node)
 {
-    avl_node_t* pivot = root->right;
-    avl_node_t* pivot_left = pivot->left;
+    return node ? node->size : 0;
+}
 
-    pivot->left = root;
-    root->right = pivot_left;    
-    UpdateHeight(root);
-    UpdateHeight(pivot);
+static void UpdateSize(avl_node_t* node)
+{
+    node->size = 1 + GetSubtreeSize(node->left) + GetSubtreeSize(node->right);
+}
+
+#define AVL_NODE avl_node_t
+#define AVL_UPDATE UpdateSize
+#include "avl_balance.h"
+
+static void SetChildren(avl_node_t* node, avl_node_t* left,
+                                                            avl_node_t* right)
+{
+    node->left = left;
+    node->right = right;
+
+    if(left)
+    {
+        left->parent = node;
+    }
+
+    if(right)
+    {
+        right->parent = node;
+    }
 
-    return pivot;
+    UpdateHeight(node);
 }
 
-static avl_node_t* RotateRight(avl_node_t* root)
+static avl_node_t* Detach(avl_node_t* node)
 {
-    avl_node_t* pivot = root->left;
-    avl_node_t* pivot_right = pivot->right;
+    if(node)
+    {
+        node->parent = NULL;
+    }
+
+    return node;
+}
+
+/* joins when @left is higher, by going down its right spine */
+static avl_node_t* JoinRight(avl_node_t* left, avl_node_t* pivot,
+                                                            avl_node_t* right)
+{
+    avl_node_t* spine = left->right;
+
+    if(GetHeight(spine) <= GetHeight(right) + 1)
+    {
+        SetChildren(pivot, spine, right);
+        spine = pivot;
+    }
+
+    else
+    {
+        spine = JoinRight(spine, pivot, right);
+    }
 
-    pivot->right = root;
-    root->left = pivot_right;   
-    UpdateHeight(root);
-    UpdateHeight(pivot);
+    left->right = spine;
+    spine->parent = left;
+    UpdateHeight(left);
 
-    return pivot;
+    return CheckBalance(left);
 }
 
-static int GetBalanceFactor(avl_node_t* node)
+/* joins when @right is higher, by going down its left spine */
+static avl_node_t* JoinLeft(avl_node_t* left, avl_node_t* pivot,
+                                                            avl_node_t* right)
 {
-    int left_height = node->left ? (int)node->left->height : 0;
-    int right_height = node->right ? (int)node->right->height : 0;
+    avl_node_t* spine = right->left;
+
+    if(GetHeight(spine) <= GetHeight(left) + 1)
+    {
+        SetChildren(pivot, left, spine);
+        spine = pivot;
+    }
+
+    else
+    {
+        spine = JoinLeft(left, pivot, spine);
+    }
 
-    return right_height - left_height - (!node->right) + (!node->left);
+    right->left = spine;
+    spine->parent = right;
+    UpdateHeight(right);
+
+    return CheckBalance(right);
 }
 
-static avl_node_t* CheckBalance(avl_node_t* root)
-{ 
-    int balance_factor = GetBalanceFactor(root);
-    int child_balance_factor = 0;
+/*
+*   joins two detached subtrees where all of @left is less than @pivot and all
+*   of @right is greater than it, in O(|height(left) - height(right)| + 1)
+*/
+static avl_node_t* Join(avl_node_t* left, avl_node_t* pivot,
+                                                            avl_node_t* right)
+{
+    avl_node_t* root = pivot;
 
-    if(balance_factor > 1)
+    if(GetHeight(left) > GetHeight(right) + 1)
     {
-        child_balance_factor = GetBalanceFactor(root->right);
+        root = JoinRight(left, pivot, right);
+    }
 
-        if(child_balance_factor < 0)
-        {
-            root->right = RotateRight(root->right);
-        }
+    else if(GetHeight(right) > GetHeight(left) + 1)
+    {
+        root = JoinLeft(left, pivot, right);
+    }
 
-        root = RotateLeft(root);
+    else
+    {
+        SetChildren(pivot, left, right);
     }
 
-    else if(balance_factor < -1)
+    return Detach(root);
+}
+
+/* detaches the last node of the subtree and returns the rest joined */
+static avl_node_t* SplitLast(avl_node_t* node, avl_node_t** last)
+{
+    avl_node_t* rest = NULL;
+
+    if(!node->right)
     {
-        child_balance_factor = GetBalanceFactor(root->left);
-        if(child_balance_factor > 0)
-        {
-            root->left = RotateLeft(root->left);
-        }
+        *last = node;
+        return Detach(node->left);
+    }
+
+    rest = SplitLast(Detach(node->right), last);
+
+    return Join(Detach(node->left), node, rest);
+}
+
+/* joins two detached subtrees where all of @left is less than all of @right */
+static avl_node_t* Join2(avl_node_t* left, avl_node_t* right)
+{
+    avl_node_t* pivot = NULL;
 
-        root = RotateRight(root);
+    if(!left)
+    {
+        return right;
     }
 
-    return root;
+    left = SplitLast(left, &pivot);
+
+    return Join(left, pivot, right);
 }
 
-static avl_node_t* PlaceNode(avl_node_t* root, compare_func_t compare_func,
-                                                        avl_node_t* new_node)
+/*
+*   splits the detached subtree of @node to the elements less than @param (or
+*   not greater than it if @is_inclusive) and to the rest
+*/
+static void Split(const avl_t* avl, avl_node_t* node, const void* param,
+            int is_inclusive, avl_node_t** left, avl_node_t** right)
 {
+    avl_node_t* node_left = NULL;
+    avl_node_t* node_right = NULL;
     int compare_result = 0;
 
-    if(!root)
+    if(!node)
     {
-        return new_node;
+        *left = NULL;
+        *right = NULL;
+        return;
     }
 
-    compare_result = compare_func(root->data, new_node->data);
-
-    assert(compare_result);
+    node_left = Detach(node->left);
+    node_right = Detach(node->right);
+    compare_result = avl->compare_func(node->data, param);
 
-    if(compare_result > 0)
+    if(compare_result < 0 || (is_inclusive && compare_result == 0))
     {
-        root->left = PlaceNode(root->left, compare_func, new_node);
+        Split(avl, node_right, param, is_inclusive, &node_right, right);
+        *left = Join(node_left, node, node_right);
     }
 
     else
     {
-        root->right = PlaceNode(root->right, compare_func, new_node);
+        Split(avl, node_left, param, is_inclusive, left, &node_left);
+        *right = Join(node_left, node, node_right);
+    }
+}
+
+static avl_node_t* DetachRoot(avl_t* avl)
+{
+    avl_node_t* root = Detach(GetRoot(avl));
+
+    avl->dummy.left = NULL;
+
+    return root;
+}
+
+static void AttachRoot(avl_t* avl, avl_node_t* root)
+{
+    avl->dummy.left = root;
+
+    if(root)
+    {
+        root->parent = &avl->dummy;
+    }
+}
+
+static avl_node_t* BuildBalanced(avl_node_t* nodes, void** array, size_t n,
+                                                        node_block_t* block)
+{
+    avl_node_t* node = NULL;
+    size_t middle = n / 2;
+
+    if(n == 0)
+    {
+        return NULL;
+    }
+
+    node = &nodes[middle];
+    node->data = array[middle];
+    node->block = block;
+    node->parent = NULL;
+    SetChildren(node, BuildBalanced(nodes, array, middle, block),
+        BuildBalanced(nodes + middle + 1, array + middle + 1, n - middle - 1,
+                                                                        block));
+
+    return node;
+}
+
+avl_t* AVLCreateFromSorted(compare_func_t compare_func, void** array,
+                                                            size_t n_elements)
+{
+    avl_t* avl = NULL;
+    node_block_t* block = NULL;
+
+    assert(compare_func);
+    assert(array || n_elements == 0);
+
+    avl = AVLCreate(compare_func);
+
+    if(!avl || n_elements == 0)
+    {
+        return avl;
+    }
+
+    block = (node_block_t*)malloc(sizeof(node_block_t) +
+                                            n_elements * sizeof(avl_node_t));
+
+    if(!block)
+    {
+        free(avl);
+        return NULL;
+    }
+
+    block->n_live = n_elements;
+    AttachRoot(avl, BuildBalanced((avl_node_t*)(block + 1), array, n_elements,
+                                                                        block));
+
+    return avl;
+}
+
+void AVLJoin(avl_t* dst, avl_t* src)
+{
+    assert(dst);
+    assert(src);
+    assert(dst != src);
+    assert(dst->fsa == src->fsa);
+    assert(AVLIsEmpty(dst) || AVLIsEmpty(src) ||
+                dst->compare_func(AVLGetValue(AVLPrev(AVLEnd(dst))),
+                                        AVLGetValue(AVLBegin(src))) < 0);
+
+    AttachRoot(dst, Join2(DetachRoot(dst), DetachRoot(src)));
+}
+
+avl_t* AVLSplit(avl_t* avl, const void* param)
+{
+    avl_t* greater = NULL;
+    avl_node_t* less_root = NULL;
+    avl_node_t* greater_root = NULL;
+
+    assert(avl);
+
+    greater = AVLCreate(avl->compare_func);
+
+    if(!greater)
+    {
+        return NULL;
     }
 
-    UpdateHeight(root);
-    return CheckBalance(root);
+    greater->fsa = avl->fsa;
+
+    Split(avl, DetachRoot(avl), param, 0, &less_root, &greater_root);
+    AttachRoot(avl, less_root);
+    AttachRoot(greater, greater_root);
+
+    return greater;
 }
 
 int AVLInsert(avl_t* avl, const void* data)
 {
     avl_node_t* node = NULL;
+    avl_node_t* parent = NULL;
+    avl_node_t** runner = NULL;
+    int compare_result = 0;
 
     assert(avl);
 
-    node = (avl_node_t*)malloc(sizeof(avl_node_t));
+    node = avl->fsa ? (avl_node_t*)FSAAlloc(avl->fsa) :
+                                    (avl_node_t*)malloc(sizeof(avl_node_t));
 
     if(!node)
     {
@@ -173,148 +452,353 @@ int AVLInsert(avl_t* avl, const void* data)
     node->data = (void*)data;
     node->left = NULL;
     node->right = NULL;
-    node->height = 0;
-    avl->root = PlaceNode(avl->root, avl->compare_func, node);
+    node->height = 1;
+    node->size = 1;
+    node->block = NULL;
+
+    parent = &avl->dummy;
+    runner = &parent->left;
+
+    while(*runner)
+    {
+        parent = *runner;
+        compare_result = avl->compare_func(parent->data, data);
+        assert(compare_result);
+        runner = compare_result > 0 ? &parent->left : &parent->right;
+    }
+
+    *runner = node;
+    node->parent = parent;
+    Retrace(parent, &avl->dummy);
 
     return 0;
 }
 
-static avl_node_t* RemoveNextInOrder(avl_node_t* node_to_cpy, avl_node_t* node)
+static avl_node_t* RunLeft(avl_node_t* node)
 {
-    avl_node_t* node_cpy = NULL;
-
-    if(node->left)
+    while(node->left)
     {
-        node->left = RemoveNextInOrder(node_to_cpy, node->left);
-        UpdateHeight(node);
-        return CheckBalance(node);
+        node = node->left;
     }
 
-    node_cpy = node->right;
-    node_to_cpy->data = node->data;
-    free(node);
-
-    return node_cpy;
+    return node;
 }
 
-static avl_node_t* RemoveNode(avl_node_t* node)
+static avl_node_t* RunRight(avl_node_t* node)
 {
-    avl_node_t* child = NULL;
-
-    if(node->right)
+    while(node->right)
     {
-        node->right = RemoveNextInOrder(node, node->right);
-        UpdateHeight(node);
-        return CheckBalance(node);
+        node = node->right;
     }
 
-    child = node->left;
-    free(node);
-    
-    return child; 
+    return node;
 }
 
-static avl_node_t* FindNodeToRemove(avl_node_t* root,
-                                compare_func_t compare_func, const void* param)
+static avl_node_t* FindNode(const avl_t* avl, const void* param)
 {
-    int compare_result = 0;
+    avl_node_t* node = GetRoot(avl);
+    int compare = 0;
 
-    if(!root)
+    while(node)
     {
-        return NULL;
-    }
+        compare = avl->compare_func(node->data, param);
 
-    compare_result = compare_func(root->data, param);
+        if(compare == 0)
+        {
+            return node;
+        }
 
-    if(compare_result == 0)
-    {
-        root = RemoveNode(root);
-        return root;
+        node = compare > 0 ? node->left : node->right;
     }
 
-    if(compare_result > 0)
+    return NULL;
+}
+
+static void RemoveNode(avl_t* avl, avl_node_t* node)
+{
+    avl_node_t* start = NULL;
+
+    if(node->left && node->right)
     {
-        root->left = FindNodeToRemove(root->left, compare_func, param);
+        start = ReplaceWithSuccessor(node);
     }
 
     else
     {
-        root->right = FindNodeToRemove(root->right, compare_func, param);
+        start = node->parent;
+        ReplaceChild(node->parent, node, node->left ? node->left : node->right);
     }
 
-    UpdateHeight(root);
-
-    return CheckBalance(root);
+    FreeNode(avl, node);
+    Retrace(start, &avl->dummy);
 }
 
 void AVLRemove(avl_t* avl, const void* param)
 {
+    avl_node_t* node = NULL;
+
     assert(avl);
 
-    avl->root = FindNodeToRemove(avl->root, avl->compare_func, param);
+    node = FindNode(avl, param);
+
+    if(node)
+    {
+        RemoveNode(avl, node);
+    }
 }
 
 int AVLIsEmpty(const avl_t* avl)
 {
     assert(avl);
 
-    return avl->root == NULL;
+    return GetRoot(avl) == NULL;
 }
 
 size_t AVLGetHeight(const avl_t* avl)
 {
     assert(avl);
 
-    return avl->root ? avl->root->height : 0;
+    return GetRoot(avl) ? GetRoot(avl)->height - 1 : 0;
 }
 
-static size_t CountNodes(avl_node_t* node)
+size_t AVLGetSize(const avl_t* avl)
 {
-    if(!node)
+    assert(avl);
+
+    return GetSubtreeSize(GetRoot(avl));
+}
+
+avl_iter_t AVLSelect(const avl_t* avl, size_t k)
+{
+    avl_node_t* node = NULL;
+    size_t left_size = 0;
+
+    assert(avl);
+
+    if(k >= AVLGetSize(avl))
     {
-        return 0;
+        return AVLEnd(avl);
+    }
+
+    node = GetRoot(avl);
+    left_size = GetSubtreeSize(node->left);
+
+    while(k != left_size)
+    {
+        if(k < left_size)
+        {
+            node = node->left;
+        }
+
+        else
+        {
+            k -= left_size + 1;
+            node = node->right;
+        }
+
+        left_size = GetSubtreeSize(node->left);
     }
 
-    return 1 + CountNodes(node->left) + CountNodes(node->right);
+    return NodeToIter(node);
 }
 
-size_t AVLGetSize(const avl_t* avl)
+size_t AVLRank(const avl_t* avl, const void* param)
 {
+    avl_node_t* node = NULL;
+    size_t rank = 0;
+
     assert(avl);
 
-    return CountNodes(avl->root);
+    node = GetRoot(avl);
+
+    while(node)
+    {
+        if(avl->compare_func(node->data, param) < 0)
+        {
+            rank += GetSubtreeSize(node->left) + 1;
+            node = node->right;
+        }
+
+        else
+        {
+            node = node->left;
+        }
+    }
+
+    return rank;
 }
 
-static void* FindNode(avl_node_t* node, compare_func_t compare_func,
-                                                            const void* param)
+void* AVLFind(const avl_t* avl, const void* param)
 {
-    int compare = 0;
+    avl_node_t* node = NULL;
 
-    if(!node)
+    assert(avl);
+
+    node = FindNode(avl, param);
+
+    return node ? node->data : NULL;
+}
+
+avl_iter_t AVLLowerBound(const avl_t* avl, const void* param)
+{
+    avl_node_t* node = NULL;
+    avl_node_t* bound = NULL;
+
+    assert(avl);
+
+    node = GetRoot(avl);
+    bound = (avl_node_t*)&avl->dummy;
+
+    while(node)
     {
-        return NULL;
+        if(avl->compare_func(node->data, param) >= 0)
+        {
+            bound = node;
+            node = node->left;
+        }
+
+        else
+        {
+            node = node->right;
+        }
+    }
+
+    return NodeToIter(bound);
+}
+
+avl_iter_t AVLUpperBound(const avl_t* avl, const void* param)
+{
+    avl_node_t* node = NULL;
+    avl_node_t* bound = NULL;
+
+    assert(avl);
+
+    node = GetRoot(avl);
+    bound = (avl_node_t*)&avl->dummy;
+
+    while(node)
+    {
+        if(avl->compare_func(node->data, param) > 0)
+        {
+            bound = node;
+            node = node->left;
+        }
+
+        else
+        {
+            node = node->right;
+        }
+    }
+
+    return NodeToIter(bound);
+}
+
+avl_iter_t AVLBegin(const avl_t* avl)
+{
+    assert(avl);
+
+    return NodeToIter(RunLeft((avl_node_t*)&avl->dummy));
+}
+
+avl_iter_t AVLEnd(const avl_t* avl)
+{
+    assert(avl);
+
+    return NodeToIter((avl_node_t*)&avl->dummy);
+}
+
+avl_iter_t AVLNext(avl_iter_t iter)
+{
+    avl_node_t* node = iter.node;
+
+    assert(node);
+
+    if(node->right)
+    {
+        return NodeToIter(RunLeft(node->right));
     }
 
-    compare = compare_func(node->data, param);
+    while(node->parent->left != node)
+    {
+        node = node->parent;
+    }
+
+    return NodeToIter(node->parent);
+}
+
+avl_iter_t AVLPrev(avl_iter_t iter)
+{
+    avl_node_t* node = iter.node;
+
+    assert(node);
 
-    if(compare == 0)
+    if(node->left)
     {
-        return node->data;
+        return NodeToIter(RunRight(node->left));
     }
 
-    if(compare > 0)
+    while(node->parent->left == node)
     {
-        return FindNode(node->left, compare_func, param);
+        node = node->parent;
     }
 
-    return FindNode(node->right, compare_func, param);
+    return NodeToIter(node->parent);
 }
 
-void* AVLFind(const avl_t* avl, const void* param)
+void* AVLGetValue(avl_iter_t iter)
+{
+    assert(iter.node);
+
+    return iter.node->data;
+}
+
+int AVLIsSameIter(avl_iter_t one, avl_iter_t other)
+{
+    return one.node == other.node;
+}
+
+ssize_t AVLFindRange(const avl_t* avl, const void* from, const void* to,
+                                                        dl_list_t* out_list)
+{
+    avl_iter_t iter;
+    size_t count = 0;
+
+    assert(avl);
+    assert(out_list);
+
+    iter = AVLLowerBound(avl, from);
+
+    for(; !AVLIsSameIter(iter, AVLEnd(avl)) &&
+            avl->compare_func(AVLGetValue(iter), to) <= 0; iter = AVLNext(iter))
+    {
+        if(DLListIsSameIter(DLListPushBack(out_list, AVLGetValue(iter)),
+                                                        DLListEnd(out_list)))
+        {
+            return -1;
+        }
+
+        ++count;
+    }
+
+    return (ssize_t)count;
+}
+
+size_t AVLRemoveRange(avl_t* avl, const void* from, const void* to)
 {
+    avl_node_t* less = NULL;
+    avl_node_t* range = NULL;
+    avl_node_t* greater = NULL;
+    size_t count = 0;
+
     assert(avl);
 
-    return FindNode(avl->root, avl->compare_func, param);
+    Split(avl, DetachRoot(avl), from, 0, &less, &range);
+    Split(avl, range, to, 1, &range, &greater);
+    count = GetSubtreeSize(range);
+    DestroyNodes(avl, range);
+    AttachRoot(avl, Join2(less, greater));
+
+    return count;
 }
 
 static int PreOrderForEach(avl_node_t* node, action_func_t action_func,
@@ -407,55 +891,49 @@ int AVLForEach(const avl_t* avl, action_func_t action_func, void* param,
     switch(order)
     {
         case PRE:
-            return PreOrderForEach(avl->root, action_func, param);
-        
+            return PreOrderForEach(GetRoot(avl), action_func, param);
+
         case IN:
-            return InOrderForEach(avl->root, action_func, param);
+            return InOrderForEach(GetRoot(avl), action_func, param);
 
         default:
-            return PostOrderForEach(avl->root, action_func, param);         
-    } 
+            return PostOrderForEach(GetRoot(avl), action_func, param);
+    }
 }
 
-static size_t TraverseAndPushToList(avl_t* avl, avl_node_t* node,
-        is_match_t match_func, void* param, dl_list_t* out_list, int to_remove)
+static ssize_t FindAndMaybeRemove(const avl_t* avl, is_match_t match_func,
+                                void* param, dl_list_t* out_list, int to_remove)
 {
-    int is_match = 0;
-    size_t left_matches = 0;
-    dll_iter_t iter = DLListEnd(out_list);
+    avl_iter_t iter = AVLBegin(avl);
+    dll_iter_t first_found = DLListEnd(out_list);
+    dll_iter_t pushed = DLListEnd(out_list);
+    size_t result = 0;
+    int failed = 0;
 
-    if(!node)
+    for(; !failed && !AVLIsSameIter(iter, AVLEnd(avl)); iter = AVLNext(iter))
     {
-        return 0;
-    }
-    
-    left_matches = TraverseAndPushToList(avl, node->left, match_func, param,
-                                                        out_list, to_remove);  
-    is_match = match_func(node->data, param);
+        if(!match_func(AVLGetValue(iter), param))
+        {
+            continue;
+        }
 
-    if(is_match)
-    {
-        iter = DLListPushBack(out_list, node->data);
-        
-        if(to_remove && !DLListIsSameIter(iter, DLListEnd(out_list)))
+        pushed = DLListPushBack(out_list, AVLGetValue(iter));
+        failed = DLListIsSameIter(pushed, DLListEnd(out_list));
+
+        if(!failed && result++ == 0)
         {
-            AVLRemove(avl, node->data);
+            first_found = pushed;
         }
     }
-    
-    return (size_t)is_match + left_matches + TraverseAndPushToList(avl,
-                        node->right, match_func, param, out_list, to_remove);
-}
 
-static ssize_t FindAndMaybeRemove(const avl_t* avl, is_match_t match_func,
-                                void* param, dl_list_t* out_list, int to_remove)
-{
-    size_t curr_list_size = DLListSize(out_list);
-    size_t result = TraverseAndPushToList((avl_t*)avl, avl->root, match_func,
-                                                    param, out_list, to_remove);
+    /* removing frees the node the walk stands on, so it is done after it */
+    for(; to_remove && !DLListIsSameIter(first_found, DLListEnd(out_list));
+                                        first_found = DLListNext(first_found))
+    {
+        AVLRemove((avl_t*)avl, DLListGetValue(first_found));
+    }
 
-    return curr_list_size + result == DLListSize(out_list) ? (ssize_t)result :
-                                                                            -1;
+    return failed ? -1 : (ssize_t)result;
 }
 
 ssize_t AVLMultipleFind(const avl_t* avl, is_match_t match_func, void* param,
@@ -476,4 +954,4 @@ ssize_t AVLMultipleRemove(const avl_t* avl, is_match_t match_func, void* param,
     assert(out_list);
 
     return FindAndMaybeRemove(avl, match_func, param, out_list, 1);
-}
\ No newline at end of file
+}
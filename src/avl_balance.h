@@ -0,0 +1,184 @@
+#ifndef __AVL_BALANCE_H__
+#define __AVL_BALANCE_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*   AVL rebalancing shared by the AVL based trees, not a public header. A
+*   source file defines the following before including it, once:
+*   @AVL_NODE: the node type, with @left, @right, @parent and @height members
+*   @AVL_UPDATE: function updating the fields a node keeps about its subtree
+*   from its children, called on every node whose subtree changed, bottom up
+*/
+#if !defined(AVL_NODE) || !defined(AVL_UPDATE)
+#error "AVL_NODE and AVL_UPDATE must be defined before avl_balance.h"
+#endif
+
+static size_t GetHeight(const AVL_NODE* node)
+{
+    return node ? node->height : 0;
+}
+
+static void UpdateHeight(AVL_NODE* node)
+{
+    size_t left_height = GetHeight(node->left);
+    size_t right_height = GetHeight(node->right);
+
+    node->height = 1 + (left_height > right_height ? left_height :
+                                                                right_height);
+    AVL_UPDATE(node);
+}
+
+static void ReplaceChild(AVL_NODE* parent, AVL_NODE* old_child,
+                                                        AVL_NODE* new_child)
+{
+    /* a detached subtree root has no parent while splitting and joining */
+    if(parent && parent->left == old_child)
+    {
+        parent->left = new_child;
+    }
+
+    else if(parent)
+    {
+        parent->right = new_child;
+    }
+
+    if(new_child)
+    {
+        new_child->parent = parent;
+    }
+}
+
+static AVL_NODE* RotateLeft(AVL_NODE* root)
+{
+    AVL_NODE* pivot = root->right;
+    AVL_NODE* pivot_left = pivot->left;
+
+    ReplaceChild(root->parent, root, pivot);
+    pivot->left = root;
+    root->parent = pivot;
+    root->right = pivot_left;
+
+    if(pivot_left)
+    {
+        pivot_left->parent = root;
+    }
+
+    UpdateHeight(root);
+    UpdateHeight(pivot);
+
+    return pivot;
+}
+
+static AVL_NODE* RotateRight(AVL_NODE* root)
+{
+    AVL_NODE* pivot = root->left;
+    AVL_NODE* pivot_right = pivot->right;
+
+    ReplaceChild(root->parent, root, pivot);
+    pivot->right = root;
+    root->parent = pivot;
+    root->left = pivot_right;
+
+    if(pivot_right)
+    {
+        pivot_right->parent = root;
+    }
+
+    UpdateHeight(root);
+    UpdateHeight(pivot);
+
+    return pivot;
+}
+
+static int GetBalanceFactor(AVL_NODE* node)
+{
+    return (int)GetHeight(node->right) - (int)GetHeight(node->left);
+}
+
+static AVL_NODE* CheckBalance(AVL_NODE* root)
+{
+    int balance_factor = GetBalanceFactor(root);
+
+    if(balance_factor > 1)
+    {
+        if(GetBalanceFactor(root->right) < 0)
+        {
+            RotateRight(root->right);
+        }
+
+        root = RotateLeft(root);
+    }
+
+    else if(balance_factor < -1)
+    {
+        if(GetBalanceFactor(root->left) > 0)
+        {
+            RotateLeft(root->left);
+        }
+
+        root = RotateRight(root);
+    }
+
+    return root;
+}
+
+/*
+*   removes @node, which has two children, from the tree by putting its
+*   successor node in its place, so handles to the successor stay valid.
+*   Returns the node to retrace from, the path up from it passes through the
+*   successor, where @AVL_UPDATE refreshes its fields
+*/
+static AVL_NODE* ReplaceWithSuccessor(AVL_NODE* node)
+{
+    AVL_NODE* next = node->right;
+    AVL_NODE* start = NULL;
+
+    while(next->left)
+    {
+        next = next->left;
+    }
+
+    start = next->parent == node ? next : next->parent;
+    ReplaceChild(next->parent, next, next->right);
+
+    next->left = node->left;
+    next->right = node->right;
+    next->height = node->height;
+    next->left->parent = next;
+
+    if(next->right)
+    {
+        next->right->parent = next;
+    }
+
+    ReplaceChild(node->parent, node, next);
+
+    return start;
+}
+
+/*
+*   walks up from @node to @end fixing heights, once a subtree height is kept
+*   no more rebalancing is needed and only @AVL_UPDATE runs above it
+*/
+static void Retrace(AVL_NODE* node, AVL_NODE* end)
+{
+    size_t old_height = 0;
+    int is_balanced = 0;
+
+    for(; node != end; node = node->parent)
+    {
+        if(is_balanced)
+        {
+            AVL_UPDATE(node);
+            continue;
+        }
+
+        old_height = node->height;
+        UpdateHeight(node);
+        node = CheckBalance(node);
+        is_balanced = node->height == old_height;
+    }
+}
+
+#endif      /* __AVL_BALANCE_H__ */
@@ -0,0 +1,825 @@
+#include <stdlib.h>     /* malloc, free */
+#include <assert.h>     /* assert */
+#include <string.h>     /* memmove, memcpy */
+
+#include "bplus_tree.h"
+
+/* both node kinds take four 64 byte cache lines with 8 byte pointers */
+#define INNER_KEYS (14)
+#define LEAF_KEYS (28)
+#define INNER_MIN (INNER_KEYS / 2)
+#define LEAF_MIN (LEAF_KEYS / 2)
+#define MAX_DEPTH (32)      /* enough for any size_t number of elements */
+
+typedef struct bpt_node
+{
+    size_t n_keys;
+    int is_leaf;
+} bpt_node_t;
+
+/*
+*   @keys[i] is the first element of the subtree @children[i + 1], which holds
+*   the elements not less than @keys[i] and less than @keys[i + 1]
+*/
+typedef struct bpt_inner
+{
+    bpt_node_t header;
+    void* keys[INNER_KEYS];
+    bpt_node_t* children[INNER_KEYS + 1];
+} bpt_inner_t;
+
+struct bpt_leaf
+{
+    bpt_node_t header;
+    bpt_leaf_t* prev;
+    bpt_leaf_t* next;
+    void* keys[LEAF_KEYS];
+};
+
+typedef struct path
+{
+    bpt_inner_t* node;
+    size_t index;       /* the child that was followed */
+} path_t;
+
+/* the root is a leaf, maybe empty, until the first split */
+struct bplus_tree
+{
+    compare_func_t compare_func;
+    bpt_node_t* root;
+    bpt_leaf_t* head;
+    bpt_leaf_t* tail;
+    size_t size;
+    size_t height;
+};
+
+static bpt_inner_t* AsInner(bpt_node_t* node)
+{
+    assert(!node->is_leaf);
+
+    return (bpt_inner_t*)node;
+}
+
+static bpt_leaf_t* AsLeaf(bpt_node_t* node)
+{
+    assert(node->is_leaf);
+
+    return (bpt_leaf_t*)node;
+}
+
+static bpt_node_t* CreateNode(int is_leaf)
+{
+    bpt_node_t* node = NULL;
+
+    node = (bpt_node_t*)malloc(is_leaf ? sizeof(bpt_leaf_t) :
+                                                        sizeof(bpt_inner_t));
+
+    if(node == NULL)
+    {
+        return NULL;
+    }
+
+    node->n_keys = 0;
+    node->is_leaf = is_leaf;
+
+    return node;
+}
+
+static void DestroyNodes(bpt_node_t* node)
+{
+    size_t index = 0;
+
+    if(!node->is_leaf)
+    {
+        for(; index <= node->n_keys; ++index)
+        {
+            DestroyNodes(AsInner(node)->children[index]);
+        }
+    }
+
+    free(node);
+}
+
+static bpt_iter_t MakeIter(bpt_leaf_t* leaf, size_t index)
+{
+    bpt_iter_t iter;
+
+    /* one past the last key of a leaf is the first key of the next one */
+    if(index == leaf->header.n_keys && leaf->next)
+    {
+        leaf = leaf->next;
+        index = 0;
+    }
+
+    iter.leaf = leaf;
+    iter.index = index;
+
+    return iter;
+}
+
+/* returns the number of keys that are not greater than @param */
+static size_t ChildIndex(const bplus_tree_t* tree, const bpt_inner_t* inner,
+                                                            const void* param)
+{
+    size_t low = 0;
+    size_t high = inner->header.n_keys;
+    size_t mid = 0;
+
+    while(low < high)
+    {
+        mid = low + (high - low) / 2;
+
+        if(tree->compare_func(inner->keys[mid], param) <= 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* returns the index of the first key not less than @param,
+   or greater than @param if @is_upper is set */
+static size_t LeafIndex(const bplus_tree_t* tree, const bpt_leaf_t* leaf,
+                                            const void* param, int is_upper)
+{
+    size_t low = 0;
+    size_t high = leaf->header.n_keys;
+    size_t mid = 0;
+    int result = 0;
+
+    while(low < high)
+    {
+        mid = low + (high - low) / 2;
+        result = tree->compare_func(leaf->keys[mid], param);
+
+        if(result < 0 || (is_upper && result == 0))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* finds the leaf @param belongs in, recording the way down if @path is set */
+static bpt_leaf_t* Descend(const bplus_tree_t* tree, const void* param,
+                                                path_t* path, size_t* depth)
+{
+    bpt_node_t* node = tree->root;
+    size_t index = 0;
+    size_t level = 0;
+
+    while(!node->is_leaf)
+    {
+        index = ChildIndex(tree, AsInner(node), param);
+
+        if(path)
+        {
+            path[level].node = AsInner(node);
+            path[level].index = index;
+        }
+
+        ++level;
+        node = AsInner(node)->children[index];
+    }
+
+    if(depth)
+    {
+        *depth = level;
+    }
+
+    return AsLeaf(node);
+}
+
+static void* FirstKey(bpt_node_t* node)
+{
+    while(!node->is_leaf)
+    {
+        node = AsInner(node)->children[0];
+    }
+
+    return AsLeaf(node)->keys[0];
+}
+
+static void LeafInsertAt(bpt_leaf_t* leaf, size_t index, void* data)
+{
+    memmove(leaf->keys + index + 1, leaf->keys + index,
+                            (leaf->header.n_keys - index) * sizeof(void*));
+    leaf->keys[index] = data;
+    ++leaf->header.n_keys;
+}
+
+static void InnerInsertAt(bpt_inner_t* inner, size_t index, void* key,
+                                                        bpt_node_t* right)
+{
+    memmove(inner->keys + index + 1, inner->keys + index,
+                            (inner->header.n_keys - index) * sizeof(void*));
+    memmove(inner->children + index + 2, inner->children + index + 1,
+                    (inner->header.n_keys - index) * sizeof(bpt_node_t*));
+    inner->keys[index] = key;
+    inner->children[index + 1] = right;
+    ++inner->header.n_keys;
+}
+
+static void* SplitLeaf(bplus_tree_t* tree, bpt_leaf_t* leaf, size_t index,
+                                            void* data, bpt_leaf_t* right)
+{
+    size_t n_left = (LEAF_KEYS + 1) - (LEAF_KEYS + 1) / 2;
+    int is_left = index < n_left;
+
+    /* the full leaf is split first, then @data goes to its half */
+    if(is_left)
+    {
+        --n_left;
+    }
+
+    right->header.n_keys = LEAF_KEYS - n_left;
+    memcpy(right->keys, leaf->keys + n_left,
+                                    right->header.n_keys * sizeof(void*));
+    leaf->header.n_keys = n_left;
+
+    if(is_left)
+    {
+        LeafInsertAt(leaf, index, data);
+    }
+    else
+    {
+        LeafInsertAt(right, index - n_left, data);
+    }
+
+    right->prev = leaf;
+    right->next = leaf->next;
+
+    if(leaf->next)
+    {
+        leaf->next->prev = right;
+    }
+    else
+    {
+        tree->tail = right;
+    }
+
+    leaf->next = right;
+
+    return right->keys[0];
+}
+
+static void* SplitInner(bpt_inner_t* inner, size_t index, void* key,
+                                    bpt_node_t* child, bpt_inner_t* right)
+{
+    void* keys[INNER_KEYS + 1];
+    bpt_node_t* children[INNER_KEYS + 2];
+    size_t n_left = (INNER_KEYS + 1) / 2;
+
+    memcpy(keys, inner->keys, index * sizeof(void*));
+    memcpy(keys + index + 1, inner->keys + index,
+                                        (INNER_KEYS - index) * sizeof(void*));
+    keys[index] = key;
+    memcpy(children, inner->children, (index + 1) * sizeof(bpt_node_t*));
+    memcpy(children + index + 2, inner->children + index + 1,
+                                (INNER_KEYS - index) * sizeof(bpt_node_t*));
+    children[index + 1] = child;
+
+    /* the middle key moves up to the parent */
+    inner->header.n_keys = n_left;
+    memcpy(inner->keys, keys, n_left * sizeof(void*));
+    memcpy(inner->children, children, (n_left + 1) * sizeof(bpt_node_t*));
+
+    right->header.n_keys = INNER_KEYS - n_left;
+    memcpy(right->keys, keys + n_left + 1,
+                                    right->header.n_keys * sizeof(void*));
+    memcpy(right->children, children + n_left + 1,
+                            (right->header.n_keys + 1) * sizeof(bpt_node_t*));
+
+    return keys[n_left];
+}
+
+/*
+*   Allocates the nodes a split of the leaf below @path may need before
+*   changing anything, one for each full node up the path and one for a new
+*   root
+*/
+static size_t AllocateSplit(path_t* path, size_t depth, bpt_node_t** spare)
+{
+    size_t count = 0;
+    size_t needed = 1;
+    size_t level = depth;
+
+    while(level > 0 && path[level - 1].node->header.n_keys == INNER_KEYS)
+    {
+        ++needed;
+        --level;
+    }
+
+    if(level == 0)
+    {
+        ++needed;
+    }
+
+    for(; count < needed; ++count)
+    {
+        spare[count] = CreateNode(count == 0);
+
+        if(spare[count] == NULL)
+        {
+            while(count > 0)
+            {
+                free(spare[--count]);
+            }
+
+            return 0;
+        }
+    }
+
+    return needed;
+}
+
+static void LeafBorrowLeft(bpt_inner_t* parent, size_t index)
+{
+    bpt_leaf_t* leaf = AsLeaf(parent->children[index]);
+    bpt_leaf_t* left = AsLeaf(parent->children[index - 1]);
+
+    LeafInsertAt(leaf, 0, left->keys[--left->header.n_keys]);
+    parent->keys[index - 1] = leaf->keys[0];
+}
+
+static void LeafBorrowRight(bpt_inner_t* parent, size_t index)
+{
+    bpt_leaf_t* leaf = AsLeaf(parent->children[index]);
+    bpt_leaf_t* right = AsLeaf(parent->children[index + 1]);
+
+    leaf->keys[leaf->header.n_keys++] = right->keys[0];
+    --right->header.n_keys;
+    memmove(right->keys, right->keys + 1,
+                                    right->header.n_keys * sizeof(void*));
+    parent->keys[index] = right->keys[0];
+}
+
+static void InnerBorrowLeft(bpt_inner_t* parent, size_t index)
+{
+    bpt_inner_t* inner = AsInner(parent->children[index]);
+    bpt_inner_t* left = AsInner(parent->children[index - 1]);
+
+    memmove(inner->keys + 1, inner->keys,
+                                    inner->header.n_keys * sizeof(void*));
+    memmove(inner->children + 1, inner->children,
+                            (inner->header.n_keys + 1) * sizeof(bpt_node_t*));
+    inner->keys[0] = parent->keys[index - 1];
+    inner->children[0] = left->children[left->header.n_keys];
+    ++inner->header.n_keys;
+
+    parent->keys[index - 1] = left->keys[--left->header.n_keys];
+}
+
+static void InnerBorrowRight(bpt_inner_t* parent, size_t index)
+{
+    bpt_inner_t* inner = AsInner(parent->children[index]);
+    bpt_inner_t* right = AsInner(parent->children[index + 1]);
+
+    inner->keys[inner->header.n_keys] = parent->keys[index];
+    inner->children[inner->header.n_keys + 1] = right->children[0];
+    ++inner->header.n_keys;
+
+    parent->keys[index] = right->keys[0];
+    --right->header.n_keys;
+    memmove(right->keys, right->keys + 1,
+                                    right->header.n_keys * sizeof(void*));
+    memmove(right->children, right->children + 1,
+                            (right->header.n_keys + 1) * sizeof(bpt_node_t*));
+}
+
+/* merges the child right of @parent->keys[index] into the one left of it */
+static void Merge(bplus_tree_t* tree, bpt_inner_t* parent, size_t index)
+{
+    bpt_node_t* left = parent->children[index];
+    bpt_node_t* right = parent->children[index + 1];
+    bpt_leaf_t* left_leaf = NULL;
+    bpt_leaf_t* right_leaf = NULL;
+    bpt_inner_t* left_inner = NULL;
+    bpt_inner_t* right_inner = NULL;
+
+    if(left->is_leaf)
+    {
+        left_leaf = AsLeaf(left);
+        right_leaf = AsLeaf(right);
+
+        memcpy(left_leaf->keys + left->n_keys, right_leaf->keys,
+                                            right->n_keys * sizeof(void*));
+        left->n_keys += right->n_keys;
+        left_leaf->next = right_leaf->next;
+
+        if(right_leaf->next)
+        {
+            right_leaf->next->prev = left_leaf;
+        }
+        else
+        {
+            tree->tail = left_leaf;
+        }
+    }
+    else
+    {
+        left_inner = AsInner(left);
+        right_inner = AsInner(right);
+
+        left_inner->keys[left->n_keys] = parent->keys[index];
+        memcpy(left_inner->keys + left->n_keys + 1, right_inner->keys,
+                                            right->n_keys * sizeof(void*));
+        memcpy(left_inner->children + left->n_keys + 1, right_inner->children,
+                                (right->n_keys + 1) * sizeof(bpt_node_t*));
+        left->n_keys += right->n_keys + 1;
+    }
+
+    free(right);
+
+    memmove(parent->keys + index, parent->keys + index + 1,
+                    (parent->header.n_keys - index - 1) * sizeof(void*));
+    memmove(parent->children + index + 1, parent->children + index + 2,
+            (parent->header.n_keys - index - 1) * sizeof(bpt_node_t*));
+    --parent->header.n_keys;
+}
+
+/* restores the minimum fill from the bottom of @path up to the root */
+static void Rebalance(bplus_tree_t* tree, bpt_node_t* node, path_t* path,
+                                                                size_t depth)
+{
+    bpt_inner_t* parent = NULL;
+    bpt_node_t* sibling = NULL;
+    size_t min = 0;
+    size_t index = 0;
+
+    for(; depth > 0; --depth)
+    {
+        min = node->is_leaf ? LEAF_MIN : INNER_MIN;
+
+        if(node->n_keys >= min)
+        {
+            return;
+        }
+
+        parent = path[depth - 1].node;
+        index = path[depth - 1].index;
+
+        if(index > 0)
+        {
+            sibling = parent->children[index - 1];
+
+            if(sibling->n_keys > min && node->is_leaf)
+            {
+                LeafBorrowLeft(parent, index);
+                return;
+            }
+
+            if(sibling->n_keys > min)
+            {
+                InnerBorrowLeft(parent, index);
+                return;
+            }
+
+            Merge(tree, parent, index - 1);
+        }
+        else
+        {
+            sibling = parent->children[index + 1];
+
+            if(sibling->n_keys > min && node->is_leaf)
+            {
+                LeafBorrowRight(parent, index);
+                return;
+            }
+
+            if(sibling->n_keys > min)
+            {
+                InnerBorrowRight(parent, index);
+                return;
+            }
+
+            Merge(tree, parent, index);
+        }
+
+        node = &parent->header;
+    }
+
+    if(!tree->root->is_leaf && tree->root->n_keys == 0)
+    {
+        node = tree->root;
+        tree->root = AsInner(node)->children[0];
+        --tree->height;
+        free(node);
+    }
+}
+
+/*
+*   A removed first key of a leaf may still be a separator on its way down,
+*   replaces it with the new first key of the subtree right of it
+*/
+static void ReplaceSeparator(bplus_tree_t* tree, const void* data)
+{
+    bpt_node_t* node = tree->root;
+    bpt_inner_t* inner = NULL;
+    size_t index = 0;
+
+    while(!node->is_leaf)
+    {
+        inner = AsInner(node);
+        index = ChildIndex(tree, inner, data);
+
+        if(index > 0 && inner->keys[index - 1] == data)
+        {
+            inner->keys[index - 1] = FirstKey(inner->children[index]);
+            return;
+        }
+
+        node = inner->children[index];
+    }
+}
+
+/*****************************************************************************/
+
+bplus_tree_t* BPTCreate(compare_func_t compare_func)
+{
+    bplus_tree_t* tree = NULL;
+
+    assert(compare_func);
+
+    tree = (bplus_tree_t*)malloc(sizeof(bplus_tree_t));
+
+    if(tree == NULL)
+    {
+        return NULL;
+    }
+
+    tree->root = CreateNode(1);
+
+    if(tree->root == NULL)
+    {
+        free(tree);
+        return NULL;
+    }
+
+    tree->compare_func = compare_func;
+    tree->head = AsLeaf(tree->root);
+    tree->tail = tree->head;
+    tree->head->prev = NULL;
+    tree->head->next = NULL;
+    tree->size = 0;
+    tree->height = 1;
+
+    return tree;
+}
+
+void BPTDestroy(bplus_tree_t* tree)
+{
+    assert(tree);
+
+    DestroyNodes(tree->root);
+    free(tree);
+}
+
+int BPTInsert(bplus_tree_t* tree, const void* data)
+{
+    path_t path[MAX_DEPTH];
+    bpt_node_t* spare[MAX_DEPTH + 1];
+    bpt_node_t* right = NULL;
+    bpt_inner_t* root = NULL;
+    bpt_leaf_t* leaf = NULL;
+    void* key = NULL;
+    size_t depth = 0;
+    size_t index = 0;
+    size_t n_spare = 0;
+    size_t used = 0;
+
+    assert(tree);
+
+    leaf = Descend(tree, data, path, &depth);
+    index = LeafIndex(tree, leaf, data, 0);
+
+    assert(index == leaf->header.n_keys ||
+                        tree->compare_func(leaf->keys[index], data) != 0);
+
+    if(leaf->header.n_keys < LEAF_KEYS)
+    {
+        LeafInsertAt(leaf, index, (void*)data);
+        ++tree->size;
+
+        return 0;
+    }
+
+    n_spare = AllocateSplit(path, depth, spare);
+
+    if(n_spare == 0)
+    {
+        return 1;
+    }
+
+    right = spare[used++];
+    key = SplitLeaf(tree, leaf, index, (void*)data, AsLeaf(right));
+
+    for(; depth > 0; --depth)
+    {
+        if(path[depth - 1].node->header.n_keys < INNER_KEYS)
+        {
+            InnerInsertAt(path[depth - 1].node, path[depth - 1].index, key,
+                                                                        right);
+            break;
+        }
+
+        key = SplitInner(path[depth - 1].node, path[depth - 1].index, key,
+                                            right, AsInner(spare[used]));
+        right = spare[used++];
+    }
+
+    if(depth == 0)
+    {
+        root = AsInner(spare[used++]);
+        root->header.n_keys = 1;
+        root->keys[0] = key;
+        root->children[0] = tree->root;
+        root->children[1] = right;
+        tree->root = &root->header;
+        ++tree->height;
+    }
+
+    assert(used == n_spare);
+    ++tree->size;
+
+    return 0;
+}
+
+void* BPTRemove(bplus_tree_t* tree, const void* param)
+{
+    path_t path[MAX_DEPTH];
+    bpt_leaf_t* leaf = NULL;
+    void* data = NULL;
+    size_t depth = 0;
+    size_t index = 0;
+
+    assert(tree);
+
+    leaf = Descend(tree, param, path, &depth);
+    index = LeafIndex(tree, leaf, param, 0);
+
+    if(index == leaf->header.n_keys ||
+                        tree->compare_func(leaf->keys[index], param) != 0)
+    {
+        return NULL;
+    }
+
+    data = leaf->keys[index];
+    --leaf->header.n_keys;
+    memmove(leaf->keys + index, leaf->keys + index + 1,
+                            (leaf->header.n_keys - index) * sizeof(void*));
+    --tree->size;
+
+    Rebalance(tree, &leaf->header, path, depth);
+
+    if(index == 0)
+    {
+        ReplaceSeparator(tree, data);
+    }
+
+    return data;
+}
+
+void* BPTFind(const bplus_tree_t* tree, const void* param)
+{
+    bpt_leaf_t* leaf = NULL;
+    size_t index = 0;
+
+    assert(tree);
+
+    leaf = Descend(tree, param, NULL, NULL);
+    index = LeafIndex(tree, leaf, param, 0);
+
+    if(index == leaf->header.n_keys ||
+                        tree->compare_func(leaf->keys[index], param) != 0)
+    {
+        return NULL;
+    }
+
+    return leaf->keys[index];
+}
+
+bpt_iter_t BPTLowerBound(const bplus_tree_t* tree, const void* param)
+{
+    bpt_leaf_t* leaf = NULL;
+
+    assert(tree);
+
+    leaf = Descend(tree, param, NULL, NULL);
+
+    return MakeIter(leaf, LeafIndex(tree, leaf, param, 0));
+}
+
+bpt_iter_t BPTUpperBound(const bplus_tree_t* tree, const void* param)
+{
+    bpt_leaf_t* leaf = NULL;
+
+    assert(tree);
+
+    leaf = Descend(tree, param, NULL, NULL);
+
+    return MakeIter(leaf, LeafIndex(tree, leaf, param, 1));
+}
+
+bpt_iter_t BPTBegin(const bplus_tree_t* tree)
+{
+    assert(tree);
+
+    return MakeIter(tree->head, 0);
+}
+
+bpt_iter_t BPTEnd(const bplus_tree_t* tree)
+{
+    assert(tree);
+
+    return MakeIter(tree->tail, tree->tail->header.n_keys);
+}
+
+bpt_iter_t BPTNext(bpt_iter_t iter)
+{
+    assert(iter.index < iter.leaf->header.n_keys);
+
+    return MakeIter(iter.leaf, iter.index + 1);
+}
+
+bpt_iter_t BPTPrev(bpt_iter_t iter)
+{
+    if(iter.index > 0)
+    {
+        --iter.index;
+    }
+    else
+    {
+        assert(iter.leaf->prev);
+
+        iter.leaf = iter.leaf->prev;
+        iter.index = iter.leaf->header.n_keys - 1;
+    }
+
+    return iter;
+}
+
+void* BPTGetValue(bpt_iter_t iter)
+{
+    assert(iter.index < iter.leaf->header.n_keys);
+
+    return iter.leaf->keys[iter.index];
+}
+
+int BPTIsSameIter(bpt_iter_t one, bpt_iter_t other)
+{
+    return one.leaf == other.leaf && one.index == other.index;
+}
+
+int BPTForEach(bpt_iter_t from, bpt_iter_t to, action_func_t action_func,
+                                                                void* param)
+{
+    int action_result = 0;
+
+    assert(action_func);
+
+    while(!BPTIsSameIter(from, to))
+    {
+        action_result = action_func(from.leaf->keys[from.index], param);
+
+        if(action_result != 0)
+        {
+            return action_result;
+        }
+
+        from = BPTNext(from);
+    }
+
+    return 0;
+}
+
+size_t BPTGetSize(const bplus_tree_t* tree)
+{
+    assert(tree);
+
+    return tree->size;
+}
+
+size_t BPTGetHeight(const bplus_tree_t* tree)
+{
+    assert(tree);
+
+    return tree->height;
+}
+
+int BPTIsEmpty(const bplus_tree_t* tree)
+{
+    assert(tree);
+
+    return tree->size == 0;
+}
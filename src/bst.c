@@ -2,6 +2,7 @@
 #include <assert.h>     /* assert */
 
 #include "bst.h"
+#include "fsa.h"
 
 struct bst_node
 {
@@ -9,12 +10,16 @@ struct bst_node
     struct bst_node* left;
     struct bst_node* right;
     struct bst_node* parent;
+    size_t priority;    /* heap ordered in @BST_TREAP, parents are higher */
 };
 
 struct bst
 {
     compare_func_t compare_func;
     bst_node_t dummy;
+    fsa_t* fsa;         /* node storage of @BSTCreateInMemory, else NULL */
+    bst_balance_t balance;
+    size_t seed;
 };
 
 static bst_node_t* IterToNode(bst_iter_t iter)
@@ -22,11 +27,12 @@ static bst_node_t* IterToNode(bst_iter_t iter)
     return iter.node;
 }
 
-static bst_iter_t NodeToIter(bst_node_t* node)
+static bst_iter_t NodeToIter(const bst_t* bst, bst_node_t* node)
 {
     bst_iter_t iter;
 
     iter.node = node;
+    iter.bst = (bst_t*)bst;
 
     return iter;
 }
@@ -48,7 +54,20 @@ static bst_iter_t PlaceNode(bst_t* bst, bst_node_t* node)
     node->parent = runner_prev;
     *runner = node;
     
-    return NodeToIter(node);
+    return NodeToIter(bst, node);
+}
+
+static void FreeNode(fsa_t* fsa, bst_node_t* node)
+{
+    if(fsa)
+    {
+        FSAFree(fsa, node);
+    }
+
+    else
+    {
+        free(node);
+    }
 }
 
 static int IsLeftChild(bst_node_t* node)
@@ -56,6 +75,111 @@ static int IsLeftChild(bst_node_t* node)
     return node->parent->left == node;
 }
 
+/* rotates @node above its parent, keeping the order of the tree */
+static void RotateUp(bst_node_t* node)
+{
+    bst_node_t* parent = node->parent;
+    bst_node_t* grand_parent = parent->parent;
+    bst_node_t* moved = NULL;
+
+    if(IsLeftChild(node))
+    {
+        moved = node->right;
+        parent->left = moved;
+        node->right = parent;
+    }
+
+    else
+    {
+        moved = node->left;
+        parent->right = moved;
+        node->left = parent;
+    }
+
+    if(moved != NULL)
+    {
+        moved->parent = parent;
+    }
+
+    if(grand_parent->left == parent)
+    {
+        grand_parent->left = node;
+    }
+
+    else
+    {
+        grand_parent->right = node;
+    }
+
+    node->parent = grand_parent;
+    parent->parent = node;
+}
+
+/* moves @node up to be a child of @top by zig-zig and zig-zag steps */
+static void Splay(bst_node_t* node, bst_node_t* top)
+{
+    bst_node_t* parent = NULL;
+
+    while(node->parent != top)
+    {
+        parent = node->parent;
+
+        if(parent->parent == top)
+        {
+            RotateUp(node);
+        }
+
+        else if(IsLeftChild(node) == IsLeftChild(parent))
+        {
+            RotateUp(parent);
+            RotateUp(node);
+        }
+
+        else
+        {
+            RotateUp(node);
+            RotateUp(node);
+        }
+    }
+}
+
+/* splays the found node, or the last one visited if @data is not found */
+static bst_iter_t SplayFind(bst_t* bst, const void* data)
+{
+    bst_node_t* iter = bst->dummy.left;
+    bst_node_t* last = NULL;
+    int compare_result = 0;
+
+    while(iter != NULL)
+    {
+        last = iter;
+        compare_result = bst->compare_func(data, iter->data);
+
+        if(compare_result == 0)
+        {
+            Splay(iter, &bst->dummy);
+
+            return NodeToIter(bst, iter);
+        }
+
+        iter = compare_result > 0 ? iter->right : iter->left;
+    }
+
+    if(last != NULL)
+    {
+        Splay(last, &bst->dummy);
+    }
+
+    return BSTEnd(bst);
+}
+
+static size_t NextPriority(bst_t* bst)
+{
+    bst->seed = bst->seed * 1103515245 + 12345;
+
+    return bst->seed >> 16;
+}
+
 static bst_node_t* RunLeft(bst_node_t* node)
 {
     while(node->left != NULL)
@@ -76,7 +200,7 @@ static bst_node_t* RunRight(bst_node_t* node)
     return node;
 }
 
-static bst_iter_t RemoveLeaf(bst_node_t* node)
+static bst_iter_t RemoveLeaf(bst_t* bst, bst_node_t* node)
 {
     bst_node_t* next = node->parent;
 
@@ -90,12 +214,12 @@ static bst_iter_t RemoveLeaf(bst_node_t* node)
         next->right = NULL;
     }
 
-    free(node);
+    FreeNode(bst->fsa, node);
 
-    return NodeToIter(next);
+    return NodeToIter(bst, next);
 }
 
-static bst_iter_t RemoveChild(bst_node_t* node, bst_node_t* next)
+static bst_iter_t RemoveChild(bst_t* bst, bst_node_t* node, bst_node_t* next)
 {
     bst_node_t* parent = node->parent;
 
@@ -111,58 +235,63 @@ static bst_iter_t RemoveChild(bst_node_t* node, bst_node_t* next)
         parent->right = next;
     }
 
-    free(node);
+    FreeNode(bst->fsa, node);
 
-    return NodeToIter(next);
+    return NodeToIter(bst, next);
 }
 
-static bst_iter_t RemoveLeftChild(bst_node_t* node)
+static bst_iter_t RemoveLeftChild(bst_t* bst, bst_node_t* node)
 {
     bst_node_t* next = node->left;
     
-    return RemoveChild(node, next);
+    return RemoveChild(bst, node, next);
 }
 
-static bst_iter_t RemoveRightChild(bst_node_t* node)
+static bst_iter_t RemoveRightChild(bst_t* bst, bst_node_t* node)
 {
     bst_node_t* next = node->right;
     
-    return RemoveChild(node, next);
+    return RemoveChild(bst, node, next);
 }
 
-static bst_iter_t RemoveNode(bst_node_t* node)
+static bst_iter_t RemoveNode(bst_t* bst, bst_node_t* node)
 {
     bst_node_t* next = NULL;
 
     if(node->left == NULL && node->right == NULL)
     {
-        return RemoveLeaf(node);
+        return RemoveLeaf(bst, node);
     }
 
     else if(node->right == NULL)
     {
-        return RemoveLeftChild(node);
+        return RemoveLeftChild(bst, node);
     }
 
     else if(node->left == NULL)
     {
-        return RemoveRightChild(node);
+        return RemoveRightChild(bst, node);
     }
 
-    next = IterToNode(BSTNext(NodeToIter(node)));
+    next = RunLeft(node->right);
     node->data = next->data;
 
     if(next->right != NULL)
     {
-        return RemoveRightChild(next);
+        return RemoveRightChild(bst, next);
     }
 
-    return RemoveLeaf(next);
+    return RemoveLeaf(bst, next);
 }
 
 /*****************************************************************************/
 
 bst_t* BSTCreate(compare_func_t compare_func)
+{
+    return BSTCreateEx(compare_func, BST_UNBALANCED);
+}
+
+bst_t* BSTCreateEx(compare_func_t compare_func, bst_balance_t balance)
 {
     bst_t* bst = NULL;
     bst_node_t dummy = {0};
@@ -178,10 +307,45 @@ bst_t* BSTCreate(compare_func_t compare_func)
 
     bst->compare_func = compare_func;
     bst->dummy = dummy;
+    bst->fsa = NULL;
+    bst->balance = balance;
+    bst->seed = (size_t)bst;
+
+    return bst;
+}
+
+size_t BSTSuggestSize(size_t n_elements)
+{
+    return FSASuggestSize(sizeof(bst_node_t), n_elements);
+}
+
+bst_t* BSTCreateInMemory(compare_func_t compare_func, void* memory,
+                                                        size_t memory_size)
+{
+    bst_t* bst = NULL;
+    fsa_t* fsa = NULL;
+
+    assert(compare_func);
+    assert(memory);
+
+    fsa = FSAInit(memory, sizeof(bst_node_t), memory_size);
+
+    if(fsa == NULL)
+    {
+        return NULL;
+    }
+
+    bst = BSTCreate(compare_func);
+
+    if(bst != NULL)
+    {
+        bst->fsa = fsa;
+    }
 
     return bst;
 }
 
+/* nodes in a caller's memory are not given back, it is reused as a whole */
 void BSTDestroy(bst_t* bst)
 {
     bst_iter_t iter;
@@ -190,9 +354,9 @@ void BSTDestroy(bst_t* bst)
 
     iter = BSTBegin(bst);
 
-    while(!BSTIsEmpty(bst))
+    while(bst->fsa == NULL && !BSTIsEmpty(bst))
     {
-        iter = RemoveNode(IterToNode(iter));
+        iter = RemoveNode(bst, IterToNode(iter));
     }
 
     free(bst);
@@ -229,7 +393,8 @@ bst_iter_t BSTInsert(bst_t* bst, const void* data)
 
     assert(bst);
 
-    node = (bst_node_t*)malloc(sizeof(bst_node_t));
+    node = bst->fsa ? (bst_node_t*)FSAAlloc(bst->fsa) :
+                                    (bst_node_t*)malloc(sizeof(bst_node_t));
 
     if(node == NULL)
     {
@@ -240,19 +405,63 @@ bst_iter_t BSTInsert(bst_t* bst, const void* data)
     node->parent = NULL;
     node->right = NULL;
     node->left = NULL;
+    node->priority = 0;
+    PlaceNode(bst, node);
+
+    if(bst->balance == BST_SPLAY)
+    {
+        Splay(node, &bst->dummy);
+    }
+
+    if(bst->balance == BST_TREAP)
+    {
+        node->priority = NextPriority(bst);
+
+        while(node->parent != &bst->dummy &&
+                                    node->parent->priority < node->priority)
+        {
+            RotateUp(node);
+        }
+    }
     
-    return PlaceNode(bst, node);
+    return NodeToIter(bst, node);
 }
 
 void* BSTRemove(bst_iter_t iter)
 {
     bst_node_t* node = IterToNode(iter);
+    bst_t* bst = NULL;
     void* data = NULL;
 
     assert(node);
 
+    bst = iter.bst;
     data = node->data;
-    RemoveNode(node);
+
+    /* the predecessor is splayed right below @node, where it has no right
+       child and can take over the right subtree of @node */
+    if(bst->balance == BST_SPLAY)
+    {
+        Splay(node, &bst->dummy);
+
+        if(node->left != NULL && node->right != NULL)
+        {
+            Splay(RunRight(node->left), node);
+            node->left->right = node->right;
+            node->right->parent = node->left;
+            node->right = NULL;
+        }
+    }
+
+    /* rotates @node down until it has one child, so no data is copied */
+    while(bst->balance == BST_TREAP && node->left != NULL &&
+                                                        node->right != NULL)
+    {
+        RotateUp(node->left->priority > node->right->priority ? node->left :
+                                                                node->right);
+    }
+
+    RemoveNode(bst, node);
     
     return data;
 }
@@ -275,14 +484,14 @@ bst_iter_t BSTBegin(const bst_t* bst)
 
     node = RunLeft((bst_node_t*)&(bst->dummy));
 
-    return NodeToIter(node);   
+    return NodeToIter(bst, node);   
 }
 
 bst_iter_t BSTEnd(const bst_t* bst)
 {
     assert(bst);
 
-    return NodeToIter((bst_node_t*)&(bst->dummy));
+    return NodeToIter(bst, (bst_node_t*)&(bst->dummy));
 }
 
 bst_iter_t BSTNext(bst_iter_t iter)
@@ -293,7 +502,7 @@ bst_iter_t BSTNext(bst_iter_t iter)
     {
         node = RunLeft(node->right);
 
-        return NodeToIter(node);
+        return NodeToIter(iter.bst, node);
     }
     
     while(!IsLeftChild(node))
@@ -301,7 +510,7 @@ bst_iter_t BSTNext(bst_iter_t iter)
         node = node->parent;
     }
 
-    return NodeToIter(node->parent);
+    return NodeToIter(iter.bst, node->parent);
 }
 
 bst_iter_t BSTPrev(bst_iter_t iter)
@@ -312,7 +521,7 @@ bst_iter_t BSTPrev(bst_iter_t iter)
     {
         node = RunRight(node->left);
 
-        return NodeToIter(node);
+        return NodeToIter(iter.bst, node);
     }
     
     while(IsLeftChild(node))
@@ -320,7 +529,7 @@ bst_iter_t BSTPrev(bst_iter_t iter)
         node = node->parent;
     }
 
-    return NodeToIter(node->parent);
+    return NodeToIter(iter.bst, node->parent);
 }
 
 bst_iter_t BSTFind(const bst_t* bst, const void* data)
@@ -330,6 +539,12 @@ bst_iter_t BSTFind(const bst_t* bst, const void* data)
 
     assert(bst);
 
+    /* the tree was allocated writable by @BSTCreateEx */
+    if(bst->balance == BST_SPLAY)
+    {
+        return SplayFind((bst_t*)bst, data);
+    }
+
     iter = bst->dummy.left;
 
     while(iter != NULL)
@@ -348,7 +563,7 @@ bst_iter_t BSTFind(const bst_t* bst, const void* data)
 
         else
         {
-            return NodeToIter(iter);
+            return NodeToIter(bst, iter);
         }
     }
 
@@ -0,0 +1,326 @@
+#include <assert.h>         /* assert */
+#include <limits.h>         /* CHAR_BIT */
+
+#include "buddy.h"
+#include "bit_array.h"
+
+#define MIN_BLOCK_SIZE (32)
+#define MAX_ORDERS (sizeof(size_t) * CHAR_BIT)
+#define WORD_BITS (sizeof(bit_array_t) * CHAR_BIT)
+
+typedef struct free_block
+{
+    struct free_block* next;
+    struct free_block* prev;
+} free_block_t;
+
+/*
+*   blocks are counted in units of @MIN_BLOCK_SIZE from @base, a block of
+*   order o is 2^o units and starts at a multiple of 2^o, its buddy is the
+*   other half of the block of order o + 1 they were split from
+*/
+struct buddy
+{
+    char* base;
+    size_t n_units;
+    size_t n_orders;
+    unsigned char* orders;      /* order of each allocated block, by its
+                                   first unit */
+    bit_array_t* free_maps[MAX_ORDERS];
+    free_block_t* free_lists[MAX_ORDERS];
+};
+
+static size_t CountWords(size_t n_units, size_t order)
+{
+    return (n_units >> order) / WORD_BITS + 1;
+}
+
+static size_t CountOrders(size_t n_units)
+{
+    size_t n_orders = 1;
+
+    while(n_orders < MAX_ORDERS && ((size_t)1 << n_orders) <= n_units)
+    {
+        ++n_orders;
+    }
+
+    return n_orders;
+}
+
+/* bytes of the bitmaps and the orders, kept after the structure */
+static size_t GetMetaSize(size_t n_units)
+{
+    size_t n_orders = CountOrders(n_units);
+    size_t meta_size = sizeof(buddy_t) + n_units;
+    size_t order = 0;
+
+    for(; order < n_orders; ++order)
+    {
+        meta_size += CountWords(n_units, order) * sizeof(bit_array_t);
+    }
+
+    return meta_size;
+}
+
+static char* AlignUp(char* address)
+{
+    size_t offset = (size_t)address % MIN_BLOCK_SIZE;
+
+    return offset ? address + MIN_BLOCK_SIZE - offset : address;
+}
+
+static int IsFree(const buddy_t* buddy, size_t unit, size_t order)
+{
+    size_t index = unit >> order;
+
+    return BitArrayGetValue(buddy->free_maps[order][index / WORD_BITS],
+                                                            index % WORD_BITS);
+}
+
+static void SetFree(buddy_t* buddy, size_t unit, size_t order, int is_free)
+{
+    size_t index = unit >> order;
+    bit_array_t* word = &buddy->free_maps[order][index / WORD_BITS];
+
+    *word = is_free ? BitArraySetBitOn(*word, index % WORD_BITS) :
+                                    BitArraySetBitOff(*word, index % WORD_BITS);
+}
+
+static free_block_t* GetBlock(const buddy_t* buddy, size_t unit)
+{
+    return (free_block_t*)(buddy->base + unit * MIN_BLOCK_SIZE);
+}
+
+static size_t GetUnit(const buddy_t* buddy, void* block)
+{
+    return (size_t)((char*)block - buddy->base) / MIN_BLOCK_SIZE;
+}
+
+static void PushFree(buddy_t* buddy, size_t unit, size_t order)
+{
+    free_block_t* block = GetBlock(buddy, unit);
+
+    block->prev = NULL;
+    block->next = buddy->free_lists[order];
+
+    if(block->next)
+    {
+        block->next->prev = block;
+    }
+
+    buddy->free_lists[order] = block;
+    SetFree(buddy, unit, order, 1);
+}
+
+static void RemoveFree(buddy_t* buddy, size_t unit, size_t order)
+{
+    free_block_t* block = GetBlock(buddy, unit);
+
+    if(block->prev)
+    {
+        block->prev->next = block->next;
+    }
+
+    else
+    {
+        buddy->free_lists[order] = block->next;
+    }
+
+    if(block->next)
+    {
+        block->next->prev = block->prev;
+    }
+
+    SetFree(buddy, unit, order, 0);
+}
+
+static size_t GetOrder(size_t alloc_size)
+{
+    size_t order = 0;
+    size_t block_size = MIN_BLOCK_SIZE;
+
+    while(block_size < alloc_size && order < MAX_ORDERS - 1)
+    {
+        block_size <<= 1;
+        ++order;
+    }
+
+    return order;
+}
+
+/*****************************************************************************/
+
+buddy_t* BuddyInit(void* memory, size_t memory_size)
+{
+    buddy_t* buddy = NULL;
+    char* meta = NULL;
+    size_t n_units = 0;
+    size_t unit = 0;
+    size_t order = 0;
+    size_t index = 0;
+
+    assert(memory);
+
+    if(memory_size <= sizeof(buddy_t))
+    {
+        return NULL;
+    }
+
+    /* every unit also costs its order byte and about two bitmap bits */
+    n_units = (memory_size - sizeof(buddy_t)) / (MIN_BLOCK_SIZE + 2);
+
+    while(n_units > 0 && GetMetaSize(n_units) + MIN_BLOCK_SIZE - 1
+                                    + n_units * MIN_BLOCK_SIZE > memory_size)
+    {
+        --n_units;
+    }
+
+    if(n_units == 0)
+    {
+        return NULL;
+    }
+
+    buddy = (buddy_t*)memory;
+    buddy->n_units = n_units;
+    buddy->n_orders = CountOrders(n_units);
+    meta = (char*)(buddy + 1);
+
+    for(order = 0; order < MAX_ORDERS; ++order)
+    {
+        buddy->free_lists[order] = NULL;
+        buddy->free_maps[order] = NULL;
+
+        if(order >= buddy->n_orders)
+        {
+            continue;
+        }
+
+        buddy->free_maps[order] = (bit_array_t*)meta;
+        for(index = 0; index < CountWords(n_units, order); ++index)
+        {
+            buddy->free_maps[order][index] = 0;
+        }
+
+        meta += CountWords(n_units, order) * sizeof(bit_array_t);
+    }
+
+    buddy->orders = (unsigned char*)meta;
+    buddy->base = AlignUp(meta + n_units);
+
+    /* the units are covered by the biggest aligned blocks that fit */
+    while(unit < n_units)
+    {
+        order = buddy->n_orders - 1;
+
+        while(unit % ((size_t)1 << order) != 0 ||
+                                        unit + ((size_t)1 << order) > n_units)
+        {
+            --order;
+        }
+
+        PushFree(buddy, unit, order);
+        unit += (size_t)1 << order;
+    }
+
+    return buddy;
+}
+
+void* BuddyAlloc(buddy_t* buddy, size_t alloc_size)
+{
+    size_t order = 0;
+    size_t split_order = 0;
+    size_t unit = 0;
+
+    assert(buddy);
+
+    if(alloc_size == 0)
+    {
+        return NULL;
+    }
+
+    order = GetOrder(alloc_size);
+    split_order = order;
+
+    while(split_order < buddy->n_orders &&
+                                        buddy->free_lists[split_order] == NULL)
+    {
+        ++split_order;
+    }
+
+    if(split_order >= buddy->n_orders)
+    {
+        return NULL;
+    }
+
+    unit = GetUnit(buddy, buddy->free_lists[split_order]);
+    RemoveFree(buddy, unit, split_order);
+
+    /* the upper halves are left free */
+    while(split_order > order)
+    {
+        --split_order;
+        PushFree(buddy, unit + ((size_t)1 << split_order), split_order);
+    }
+
+    buddy->orders[unit] = (unsigned char)order;
+
+    return GetBlock(buddy, unit);
+}
+
+void BuddyFree(buddy_t* buddy, void* block)
+{
+    size_t unit = 0;
+    size_t buddy_unit = 0;
+    size_t order = 0;
+
+    assert(buddy);
+
+    if(block == NULL)
+    {
+        return;
+    }
+
+    assert((char*)block >= buddy->base);
+    unit = GetUnit(buddy, block);
+    assert(unit < buddy->n_units);
+    order = buddy->orders[unit];
+    assert(!IsFree(buddy, unit, order));
+
+    while(order + 1 < buddy->n_orders)
+    {
+        buddy_unit = unit ^ ((size_t)1 << order);
+
+        if(buddy_unit + ((size_t)1 << order) > buddy->n_units ||
+                                        !IsFree(buddy, buddy_unit, order))
+        {
+            break;
+        }
+
+        RemoveFree(buddy, buddy_unit, order);
+        unit &= ~((size_t)1 << order);
+        ++order;
+    }
+
+    PushFree(buddy, unit, order);
+}
+
+size_t BuddyLargestChunkAvailable(const buddy_t* buddy)
+{
+    size_t order = 0;
+
+    assert(buddy);
+
+    order = buddy->n_orders;
+
+    while(order > 0)
+    {
+        --order;
+
+        if(buddy->free_lists[order])
+        {
+            return (size_t)MIN_BLOCK_SIZE << order;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,262 @@
+#define _POSIX_C_SOURCE 200112L     /* sysconf, pthread_rwlock_t */
+
+#include <stdlib.h>                  /* malloc, posix_memalign, free */
+#include <assert.h>                  /* assert */
+#include <pthread.h>                 /* pthread_rwlock_t, pthread_key_t */
+#include <unistd.h>                  /* sysconf */
+
+#include "concurrent_avl.h"
+
+#define MIN_SLOTS (1)
+#define CACHE_LINE (64)
+
+/* slots are line aligned and fill whole lines, so no two locks share one */
+typedef struct read_slot
+{
+    pthread_rwlock_t lock;
+    char padding[CACHE_LINE - sizeof(pthread_rwlock_t) % CACHE_LINE];
+} read_slot_t;
+
+struct concurrent_avl
+{
+    avl_t* avl;
+    read_slot_t* slots;
+    size_t n_slots;
+    pthread_key_t slot_key;
+    pthread_mutex_t assign_lock;
+    size_t next_slot;
+};
+
+static size_t CountSlots(void)
+{
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t n_slots = n_cpus > 0 ? (size_t)n_cpus : 0;
+
+    return n_slots < MIN_SLOTS ? MIN_SLOTS : n_slots;
+}
+
+static void DestroySlots(concurrent_avl_t* map, size_t n_slots)
+{
+    size_t index = 0;
+
+    for(; index < n_slots; ++index)
+    {
+        pthread_rwlock_destroy(&map->slots[index].lock);
+    }
+}
+
+static int InitSlots(concurrent_avl_t* map)
+{
+    size_t index = 0;
+
+    for(; index < map->n_slots; ++index)
+    {
+        if(pthread_rwlock_init(&map->slots[index].lock, NULL) != 0)
+        {
+            DestroySlots(map, index);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* threads are spread over the slots round robin on their first read, the
+   slot is stored plus one as the thread specific value */
+static read_slot_t* GetSlot(concurrent_avl_t* map)
+{
+    size_t slot = (size_t)pthread_getspecific(map->slot_key);
+
+    if(slot == 0)
+    {
+        pthread_mutex_lock(&map->assign_lock);
+        slot = map->next_slot % map->n_slots + 1;
+        ++map->next_slot;
+        pthread_mutex_unlock(&map->assign_lock);
+
+        pthread_setspecific(map->slot_key, (void*)slot);
+    }
+
+    return &map->slots[slot - 1];
+}
+
+static read_slot_t* ReadLock(concurrent_avl_t* map)
+{
+    read_slot_t* slot = GetSlot(map);
+
+    pthread_rwlock_rdlock(&slot->lock);
+
+    return slot;
+}
+
+/* slots are always locked in the same order, so writers never deadlock */
+static void WriteLock(concurrent_avl_t* map)
+{
+    size_t index = 0;
+
+    for(; index < map->n_slots; ++index)
+    {
+        pthread_rwlock_wrlock(&map->slots[index].lock);
+    }
+}
+
+static void WriteUnlock(concurrent_avl_t* map)
+{
+    size_t index = map->n_slots;
+
+    while(index > 0)
+    {
+        pthread_rwlock_unlock(&map->slots[--index].lock);
+    }
+}
+
+/*****************************************************************************/
+
+concurrent_avl_t* CAVLCreate(compare_func_t compare_func)
+{
+    concurrent_avl_t* map = NULL;
+    void* slots = NULL;
+
+    assert(compare_func);
+
+    map = (concurrent_avl_t*)malloc(sizeof(concurrent_avl_t));
+
+    if(map == NULL)
+    {
+        return NULL;
+    }
+
+    map->n_slots = CountSlots();
+    map->next_slot = 0;
+
+    if(posix_memalign(&slots, CACHE_LINE, map->n_slots * sizeof(read_slot_t)))
+    {
+        free(map);
+        return NULL;
+    }
+
+    map->slots = (read_slot_t*)slots;
+
+    map->avl = AVLCreate(compare_func);
+
+    if(map->avl == NULL)
+    {
+        free(map->slots);
+        free(map);
+        return NULL;
+    }
+
+    if(InitSlots(map))
+    {
+        AVLDestroy(map->avl);
+        free(map->slots);
+        free(map);
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&map->assign_lock, NULL) != 0)
+    {
+        DestroySlots(map, map->n_slots);
+        AVLDestroy(map->avl);
+        free(map->slots);
+        free(map);
+        return NULL;
+    }
+
+    if(pthread_key_create(&map->slot_key, NULL) != 0)
+    {
+        pthread_mutex_destroy(&map->assign_lock);
+        DestroySlots(map, map->n_slots);
+        AVLDestroy(map->avl);
+        free(map->slots);
+        free(map);
+        return NULL;
+    }
+
+    return map;
+}
+
+void CAVLDestroy(concurrent_avl_t* map)
+{
+    assert(map);
+
+    pthread_key_delete(map->slot_key);
+    pthread_mutex_destroy(&map->assign_lock);
+    DestroySlots(map, map->n_slots);
+    AVLDestroy(map->avl);
+    free(map->slots);
+    free(map);
+}
+
+int CAVLInsert(concurrent_avl_t* map, const void* data)
+{
+    int result = 0;
+
+    assert(map);
+
+    WriteLock(map);
+    result = AVLInsert(map->avl, data);
+    WriteUnlock(map);
+
+    return result;
+}
+
+void CAVLRemove(concurrent_avl_t* map, const void* param)
+{
+    assert(map);
+
+    WriteLock(map);
+    AVLRemove(map->avl, param);
+    WriteUnlock(map);
+}
+
+void* CAVLFind(concurrent_avl_t* map, const void* param)
+{
+    read_slot_t* slot = NULL;
+    void* data = NULL;
+
+    assert(map);
+
+    slot = ReadLock(map);
+    data = AVLFind(map->avl, param);
+    pthread_rwlock_unlock(&slot->lock);
+
+    return data;
+}
+
+int CAVLForEach(concurrent_avl_t* map, action_func_t action_func, void* param,
+                                                    traversal_order_t order)
+{
+    read_slot_t* slot = NULL;
+    int result = 0;
+
+    assert(map);
+    assert(action_func);
+
+    slot = ReadLock(map);
+    result = AVLForEach(map->avl, action_func, param, order);
+    pthread_rwlock_unlock(&slot->lock);
+
+    return result;
+}
+
+size_t CAVLGetSize(concurrent_avl_t* map)
+{
+    read_slot_t* slot = NULL;
+    size_t size = 0;
+
+    assert(map);
+
+    slot = ReadLock(map);
+    size = AVLGetSize(map->avl);
+    pthread_rwlock_unlock(&slot->lock);
+
+    return size;
+}
+
+int CAVLIsEmpty(concurrent_avl_t* map)
+{
+    assert(map);
+
+    return CAVLGetSize(map) == 0;
+}
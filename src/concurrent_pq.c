@@ -0,0 +1,342 @@
+#define _POSIX_C_SOURCE 200112L     /* sysconf, pthread */
+
+#include <stdlib.h>                  /* malloc, posix_memalign, free */
+#include <assert.h>                  /* assert */
+#include <pthread.h>                 /* pthread_mutex_t, pthread_key_t */
+#include <unistd.h>                  /* sysconf */
+
+#include "concurrent_pq.h"
+#include "heap.h"
+
+#define QUEUES_PER_CPU (2)
+#define MIN_QUEUES (2)
+#define CACHE_LINE (64)
+
+/* queues are line aligned and fill whole lines, so no two locks share one */
+typedef struct sub_queue
+{
+    pthread_mutex_t lock;
+    heap_t* heap;
+    char padding[CACHE_LINE - (sizeof(pthread_mutex_t) + sizeof(heap_t*))
+                                                                % CACHE_LINE];
+} sub_queue_t;
+
+struct priority_queue
+{
+    sub_queue_t* queues;
+    size_t n_queues;
+    int (*compare_func)(const void*, const void*);
+    pthread_key_t seed_key;
+};
+
+/* per thread generator, its state is stored as the thread specific value */
+static size_t NextRandom(const concurrent_pq_t* pq)
+{
+    size_t seed = (size_t)pthread_getspecific(pq->seed_key);
+
+    if(seed == 0)
+    {
+        seed = (size_t)&seed;
+    }
+
+    seed = seed * 1103515245 + 12345;
+    pthread_setspecific(pq->seed_key, (void*)seed);
+
+    return seed >> 16;
+}
+
+static void DestroyQueues(concurrent_pq_t* pq, size_t n_queues)
+{
+    size_t index = 0;
+
+    for(; index < n_queues; ++index)
+    {
+        HeapDestroy(pq->queues[index].heap);
+        pthread_mutex_destroy(&pq->queues[index].lock);
+    }
+}
+
+static int InitQueues(concurrent_pq_t* pq)
+{
+    size_t index = 0;
+
+    for(; index < pq->n_queues; ++index)
+    {
+        pq->queues[index].heap = HeapCreate(pq->compare_func);
+
+        if(pq->queues[index].heap == NULL)
+        {
+            DestroyQueues(pq, index);
+            return 1;
+        }
+
+        if(pthread_mutex_init(&pq->queues[index].lock, NULL) != 0)
+        {
+            HeapDestroy(pq->queues[index].heap);
+            DestroyQueues(pq, index);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static size_t CountQueues(void)
+{
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t n_queues = n_cpus > 0 ? (size_t)n_cpus * QUEUES_PER_CPU : 0;
+
+    return n_queues < MIN_QUEUES ? MIN_QUEUES : n_queues;
+}
+
+/* returns the better non empty heap of the two, or NULL if both are empty */
+static heap_t* BetterHeap(const concurrent_pq_t* pq, heap_t* one, heap_t* other)
+{
+    if(other == NULL || HeapIsEmpty(other))
+    {
+        return HeapIsEmpty(one) ? NULL : one;
+    }
+
+    if(HeapIsEmpty(one))
+    {
+        return other;
+    }
+
+    return pq->compare_func(HeapPeek(other), HeapPeek(one)) < 0 ? other : one;
+}
+
+static void* PopLocked(heap_t* heap)
+{
+    void* data = HeapPeek(heap);
+
+    HeapPop(heap);
+
+    return data;
+}
+
+/*****************************************************************************/
+
+concurrent_pq_t* PQCreate(int (*compare_func)(const void*, const void*))
+{
+    concurrent_pq_t* pq = NULL;
+    void* queues = NULL;
+
+    assert(compare_func);
+
+    pq = (concurrent_pq_t*)malloc(sizeof(concurrent_pq_t));
+
+    if(pq == NULL)
+    {
+        return NULL;
+    }
+
+    pq->n_queues = CountQueues();
+    pq->compare_func = compare_func;
+
+    if(posix_memalign(&queues, CACHE_LINE, pq->n_queues * sizeof(sub_queue_t)))
+    {
+        free(pq);
+        return NULL;
+    }
+
+    pq->queues = (sub_queue_t*)queues;
+
+    if(InitQueues(pq))
+    {
+        free(pq->queues);
+        free(pq);
+        return NULL;
+    }
+
+    if(pthread_key_create(&pq->seed_key, NULL) != 0)
+    {
+        DestroyQueues(pq, pq->n_queues);
+        free(pq->queues);
+        free(pq);
+        return NULL;
+    }
+
+    return pq;
+}
+
+void PQDestroy(concurrent_pq_t* pq)
+{
+    assert(pq);
+
+    pthread_key_delete(pq->seed_key);
+    DestroyQueues(pq, pq->n_queues);
+    free(pq->queues);
+    free(pq);
+}
+
+int PQEnqueue(concurrent_pq_t* pq, void* data)
+{
+    sub_queue_t* queue = NULL;
+    size_t tries = 0;
+    int result = 0;
+
+    assert(pq);
+
+    queue = &pq->queues[NextRandom(pq) % pq->n_queues];
+
+    while(pthread_mutex_trylock(&queue->lock) != 0)
+    {
+        queue = &pq->queues[NextRandom(pq) % pq->n_queues];
+
+        if(++tries == pq->n_queues)
+        {
+            pthread_mutex_lock(&queue->lock);
+            break;
+        }
+    }
+
+    result = HeapPush(queue->heap, data);
+    pthread_mutex_unlock(&queue->lock);
+
+    return result;
+}
+
+void* PQDequeue(concurrent_pq_t* pq)
+{
+    sub_queue_t* one = NULL;
+    sub_queue_t* other = NULL;
+    heap_t* best = NULL;
+    void* data = NULL;
+    size_t tries = 0;
+    size_t start = 0;
+    size_t index = 0;
+
+    assert(pq);
+
+    for(; tries < pq->n_queues; ++tries)
+    {
+        one = &pq->queues[NextRandom(pq) % pq->n_queues];
+        other = &pq->queues[NextRandom(pq) % pq->n_queues];
+
+        if(pthread_mutex_trylock(&one->lock) != 0)
+        {
+            continue;
+        }
+
+        if(other == one || pthread_mutex_trylock(&other->lock) != 0)
+        {
+            other = NULL;
+        }
+
+        best = BetterHeap(pq, one->heap, other ? other->heap : NULL);
+        data = best ? PopLocked(best) : NULL;
+
+        if(other)
+        {
+            pthread_mutex_unlock(&other->lock);
+        }
+
+        pthread_mutex_unlock(&one->lock);
+
+        if(data)
+        {
+            return data;
+        }
+    }
+
+    /* random picks were busy or empty, fall back to visiting every heap */
+    start = NextRandom(pq) % pq->n_queues;
+
+    for(index = 0; index < pq->n_queues && !data; ++index)
+    {
+        one = &pq->queues[(start + index) % pq->n_queues];
+        pthread_mutex_lock(&one->lock);
+        data = HeapIsEmpty(one->heap) ? NULL : PopLocked(one->heap);
+        pthread_mutex_unlock(&one->lock);
+    }
+
+    return data;
+}
+
+void* PQPeek(const concurrent_pq_t* pq)
+{
+    sub_queue_t* queue = NULL;
+    void* best = NULL;
+    void* top = NULL;
+    size_t index = 0;
+
+    assert(pq);
+
+    for(; index < pq->n_queues; ++index)
+    {
+        queue = &pq->queues[index];
+        pthread_mutex_lock(&queue->lock);
+        top = HeapIsEmpty(queue->heap) ? NULL : HeapPeek(queue->heap);
+        pthread_mutex_unlock(&queue->lock);
+
+        if(top && (best == NULL || pq->compare_func(top, best) < 0))
+        {
+            best = top;
+        }
+    }
+
+    return best;
+}
+
+int PQIsEmpty(const concurrent_pq_t* pq)
+{
+    assert(pq);
+
+    return PQSize(pq) == 0;
+}
+
+size_t PQSize(const concurrent_pq_t* pq)
+{
+    sub_queue_t* queue = NULL;
+    size_t size = 0;
+    size_t index = 0;
+
+    assert(pq);
+
+    for(; index < pq->n_queues; ++index)
+    {
+        queue = &pq->queues[index];
+        pthread_mutex_lock(&queue->lock);
+        size += HeapSize(queue->heap);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    return size;
+}
+
+void PQClear(concurrent_pq_t* pq)
+{
+    sub_queue_t* queue = NULL;
+    size_t index = 0;
+
+    assert(pq);
+
+    for(; index < pq->n_queues; ++index)
+    {
+        queue = &pq->queues[index];
+        pthread_mutex_lock(&queue->lock);
+        HeapClear(queue->heap);
+        pthread_mutex_unlock(&queue->lock);
+    }
+}
+
+void* PQErase(concurrent_pq_t* pq, int (*is_match)(const void*, const void*),
+                                                            const void* param)
+{
+    sub_queue_t* queue = NULL;
+    void* data = NULL;
+    size_t index = 0;
+
+    assert(pq);
+    assert(is_match);
+
+    for(; index < pq->n_queues && !data; ++index)
+    {
+        queue = &pq->queues[index];
+        pthread_mutex_lock(&queue->lock);
+        data = HeapRemove(queue->heap, (void*)param, is_match);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    return data;
+}
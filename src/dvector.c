@@ -1,11 +1,11 @@
 #include <stdlib.h>                  /* malloc, realloc, free */
 #include <assert.h>                  /* assert */
-#include <string.h>                  /* memcpy */
+#include <string.h>                  /* memcpy, memmove */
 
 #include "dvector.h"
 
 #define INC_FACTOR(x) ((x * 1.5) + 1)
-#define DEC_FACTOR(x) (x * 2/3)
+#define DEC_FACTOR(x) (x / 4)
 #define SUCCESS (0)
 #define FAILURE (1)
 
@@ -14,9 +14,24 @@ struct dvector {
     size_t capacity;
     size_t element_size;
     void* array;
+    void* memory;       /* the allocation @array lies in */
+    size_t align;       /* 0 if @array is as aligned as malloc leaves it */
 };
 
+static void* AlignArray(void* memory, size_t align)
+{
+    size_t offset = align ? (size_t)memory % align : 0;
+
+    return offset ? (char*)memory + align - offset : memory;
+}
+
 dvector_t* DvectorCreate(size_t capacity, size_t element_size)
+{
+    return DvectorCreateAligned(capacity, element_size, 0);
+}
+
+dvector_t* DvectorCreateAligned(size_t capacity, size_t element_size,
+                                                                size_t align)
 {
     dvector_t* p_dvector = (dvector_t*)malloc(sizeof(dvector_t));
 
@@ -25,14 +40,16 @@ dvector_t* DvectorCreate(size_t capacity, size_t element_size)
         return NULL;
     }
 
-    p_dvector->array = malloc(capacity * element_size);
+    p_dvector->memory = malloc(capacity * element_size + align);
 
-    if (!p_dvector->array)
+    if (!p_dvector->memory)
     {
         free(p_dvector);
         return NULL;
     }
 
+    p_dvector->array = AlignArray(p_dvector->memory, align);
+    p_dvector->align = align;
     p_dvector->size = 0;
     p_dvector->capacity = capacity;
     p_dvector->element_size = element_size;
@@ -42,7 +59,7 @@ dvector_t* DvectorCreate(size_t capacity, size_t element_size)
 
 void DvectorDestroy(dvector_t* dvector)
 {
-    free(dvector -> array);
+    free(dvector -> memory);
     free(dvector);
 }
 
@@ -104,6 +121,40 @@ int DvectorPushBack(dvector_t* dvector, const void* element)
     return SUCCESS;
 }
 
+int DvectorPushBackMany(dvector_t* dvector, const void* elements,
+                                                            size_t n_elements)
+{
+    unsigned char* p_array;
+    size_t new_capacity = 0;
+
+    assert(dvector);
+    assert(elements || n_elements == 0);
+
+    if (dvector->size + n_elements > dvector->capacity)
+    {
+        /* grows geometrically like @DvectorPushBack, so small batches do not
+           reallocate every time */
+        new_capacity = INC_FACTOR(dvector->capacity);
+
+        if (new_capacity < dvector->size + n_elements)
+        {
+            new_capacity = dvector->size + n_elements;
+        }
+
+        if (FAILURE == DvectorResize(dvector, new_capacity))
+        {
+            return FAILURE;
+        }
+    }
+
+    p_array = (unsigned char*)(dvector->array);
+    memcpy(p_array + (dvector->size * dvector->element_size), elements,
+                                        n_elements * dvector->element_size);
+    dvector->size += n_elements;
+
+    return SUCCESS;
+}
+
 int DvectorPopBack(dvector_t* dvector)
 {
     assert(dvector);
@@ -115,25 +166,55 @@ int DvectorPopBack(dvector_t* dvector)
 
     dvector->size--;
 
+    /* shrinks well below the capacity and keeps room to grow, so pops and
+       pushes around one size do not resize every time */
     if (dvector->size <= DEC_FACTOR(dvector->capacity))
     {
-        DvectorShrink(dvector);
+        DvectorResize(dvector, INC_FACTOR(dvector->size));
     }
     
     return SUCCESS;
 }
 
+void DvectorClear(dvector_t* dvector)
+{
+    assert(dvector);
+
+    dvector->size = 0;
+}
+
 int DvectorResize(dvector_t* dvector, size_t new_capacity)
 {    
+    void* new_memory = NULL;
+    void* new_array = NULL;
+    size_t offset = 0;
+    size_t size = 0;
+
     assert(dvector);
 
-    dvector->array = realloc(dvector->array, new_capacity * dvector->element_size + 1);
+    offset = (char*)dvector->array - (char*)dvector->memory;
+    size = dvector->size < new_capacity ? dvector->size : new_capacity;
+
+    /* the old array is kept if the allocation fails */
+    new_memory = realloc(dvector->memory, new_capacity * dvector->element_size
+                                    + (dvector->align ? dvector->align : 1));
 
-    if (NULL == dvector->array)
+    if (NULL == new_memory)
     {
         return FAILURE;
     }
+
+    /* a moved block may start at another offset from the alignment */
+    new_array = AlignArray(new_memory, dvector->align);
+
+    if (new_array != (char*)new_memory + offset)
+    {
+        memmove(new_array, (char*)new_memory + offset,
+                                                size * dvector->element_size);
+    }
     
+    dvector->memory = new_memory;
+    dvector->array = new_array;
     dvector->capacity = new_capacity;
     dvector->size = dvector->size > dvector->capacity ? dvector->capacity : dvector->size;
     
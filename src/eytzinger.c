@@ -0,0 +1,195 @@
+#include <stdlib.h>     /* malloc, free */
+#include <assert.h>     /* assert */
+
+#include "eytzinger.h"
+
+#define CACHE_LINE (64)
+#define LEVELS_AHEAD (3)    /* the 8 nodes three levels down share a line */
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address)
+#endif
+
+/* node k has the children 2k and 2k + 1, node 0 is unused */
+struct eytzinger
+{
+    compare_func_t compare_func;
+    size_t size;
+    void** nodes;       /* aligned so the children of a line share one */
+};
+
+static eytzinger_t* CreateEytzinger(compare_func_t compare_func,
+                                                            size_t n_elements)
+{
+    eytzinger_t* eytzinger = NULL;
+    size_t address = 0;
+
+    eytzinger = (eytzinger_t*)malloc(sizeof(eytzinger_t) + CACHE_LINE +
+                                        (n_elements + 1) * sizeof(void*));
+
+    if(eytzinger == NULL)
+    {
+        return NULL;
+    }
+
+    address = (size_t)(eytzinger + 1);
+    address = (address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    eytzinger->compare_func = compare_func;
+    eytzinger->size = n_elements;
+    eytzinger->nodes = (void**)address;
+
+    return eytzinger;
+}
+
+static size_t RunLeft(size_t index, size_t size)
+{
+    while(2 * index <= size)
+    {
+        index *= 2;
+    }
+
+    return index;
+}
+
+/* returns the in-order successor of @index, 0 after the last node */
+static size_t NextInOrder(size_t index, size_t size)
+{
+    if(2 * index + 1 <= size)
+    {
+        return RunLeft(2 * index + 1, size);
+    }
+
+    /* climbs while @index is a right child, then once more */
+    while(index & 1)
+    {
+        index >>= 1;
+    }
+
+    return index >> 1;
+}
+
+/* returns the node of the first element not less than @param, 0 if none */
+static size_t LowerBound(const eytzinger_t* eytzinger, const void* param)
+{
+    size_t index = 1;
+    size_t size = eytzinger->size;
+    void** nodes = eytzinger->nodes;
+
+    while(index <= size)
+    {
+        PREFETCH(nodes + (index << LEVELS_AHEAD));
+        index = 2 * index + (eytzinger->compare_func(nodes[index], param) < 0);
+    }
+
+    /* the answer is where the walk last went left */
+    while(index & 1)
+    {
+        index >>= 1;
+    }
+
+    return index >> 1;
+}
+
+/*****************************************************************************/
+
+eytzinger_t* EytzingerCreate(compare_func_t compare_func, void** array,
+                                                            size_t n_elements)
+{
+    eytzinger_t* eytzinger = NULL;
+    size_t index = 0;
+    size_t element = 0;
+
+    assert(compare_func);
+    assert(array || n_elements == 0);
+
+    eytzinger = CreateEytzinger(compare_func, n_elements);
+
+    if(eytzinger == NULL || n_elements == 0)
+    {
+        return eytzinger;
+    }
+
+    for(index = RunLeft(1, n_elements); index != 0;
+                                    index = NextInOrder(index, n_elements))
+    {
+        eytzinger->nodes[index] = array[element++];
+    }
+
+    return eytzinger;
+}
+
+eytzinger_t* EytzingerCreateFromAVL(compare_func_t compare_func,
+                                                            const avl_t* avl)
+{
+    eytzinger_t* eytzinger = NULL;
+    avl_iter_t iter;
+    size_t n_elements = 0;
+    size_t index = 0;
+
+    assert(compare_func);
+    assert(avl);
+
+    n_elements = AVLGetSize(avl);
+    eytzinger = CreateEytzinger(compare_func, n_elements);
+
+    if(eytzinger == NULL || n_elements == 0)
+    {
+        return eytzinger;
+    }
+
+    iter = AVLBegin(avl);
+
+    for(index = RunLeft(1, n_elements); index != 0;
+                                    index = NextInOrder(index, n_elements))
+    {
+        eytzinger->nodes[index] = AVLGetValue(iter);
+        iter = AVLNext(iter);
+    }
+
+    return eytzinger;
+}
+
+void EytzingerDestroy(eytzinger_t* eytzinger)
+{
+    assert(eytzinger);
+
+    free(eytzinger);
+}
+
+void* EytzingerFind(const eytzinger_t* eytzinger, const void* param)
+{
+    size_t index = 0;
+
+    assert(eytzinger);
+
+    index = LowerBound(eytzinger, param);
+
+    if(index == 0 ||
+            eytzinger->compare_func(eytzinger->nodes[index], param) != 0)
+    {
+        return NULL;
+    }
+
+    return eytzinger->nodes[index];
+}
+
+void* EytzingerLowerBound(const eytzinger_t* eytzinger, const void* param)
+{
+    size_t index = 0;
+
+    assert(eytzinger);
+
+    index = LowerBound(eytzinger, param);
+
+    return index == 0 ? NULL : eytzinger->nodes[index];
+}
+
+size_t EytzingerGetSize(const eytzinger_t* eytzinger)
+{
+    assert(eytzinger);
+
+    return eytzinger->size;
+}
@@ -1,11 +1,23 @@
 #include <assert.h>
+#include <limits.h>     /* CHAR_BIT */
+
 #include "fsa.h"
+#include "bit_array.h"
 
 #define WORD_SIZE (sizeof(size_t))
+#define WORD_BITS (sizeof(bit_array_t) * CHAR_BIT)
 
 struct fsa
 {
     size_t next_free;
+    size_t block_size;
+    size_t n_blocks;
+    size_t n_free;
+    size_t min_free;    /* fewest free blocks so far, for the peak use */
+    bit_array_t* bitmap;    /* bit on for every free block, NULL if the
+                               free blocks are linked by their headers */
+    size_t n_words;
+    size_t first_word;      /* no free blocks before this word */
 };
 
 typedef struct header
@@ -18,6 +30,58 @@ static size_t AlignBlock(size_t block_size)
     return ((block_size + WORD_SIZE - 1) / WORD_SIZE) * WORD_SIZE;
 }
 
+static size_t CountWords(size_t n_blocks)
+{
+    return (n_blocks + WORD_BITS - 1) / WORD_BITS;
+}
+
+static size_t CountTrailingZeros(bit_array_t word)
+{
+#ifdef __GNUC__
+    return (size_t)__builtin_ctzll(word);
+#else
+    return BitArrayCountOn((word & (~word + 1)) - 1);
+#endif
+}
+
+static char* GetBlocks(const fsa_t* fsa)
+{
+    return (char*)(fsa->bitmap + fsa->n_words);
+}
+
+static void* AllocFromBitmap(fsa_t* fsa)
+{
+    bit_array_t* word = fsa->bitmap + fsa->first_word;
+    size_t index = 0;
+
+    while(*word == 0)
+    {
+        ++word;
+    }
+
+    fsa->first_word = (size_t)(word - fsa->bitmap);
+    index = fsa->first_word * WORD_BITS + CountTrailingZeros(*word);
+    *word &= *word - 1;
+
+    return GetBlocks(fsa) + index * fsa->block_size;
+}
+
+static void FreeToBitmap(fsa_t* fsa, void* p_block)
+{
+    size_t index = (size_t)((char*)p_block - GetBlocks(fsa)) / fsa->block_size;
+    size_t word = index / WORD_BITS;
+
+    assert(index < fsa->n_blocks);
+    assert(!(fsa->bitmap[word] >> (index % WORD_BITS) & 1));
+
+    fsa->bitmap[word] |= (bit_array_t)1 << (index % WORD_BITS);
+
+    if(word < fsa->first_word)
+    {
+        fsa->first_word = word;
+    }
+}
+
 size_t FSASuggestSize(size_t block_size, size_t n_blocks)
 {
     block_size = AlignBlock(block_size);
@@ -42,6 +106,9 @@ fsa_t* FSAInit(void* memory, size_t block_size, size_t memory_size)
 
     fsa = memory;
     fsa->next_free = sizeof(fsa_t);
+    fsa->block_size = block_size;
+    fsa->n_blocks = 1;
+    fsa->bitmap = NULL;
     header = (header_t*)((char*)memory + fsa->next_free);
     header->next = sizeof(fsa_t) + sizeof(header_t) + block_size;
 
@@ -50,9 +117,75 @@ fsa_t* FSAInit(void* memory, size_t block_size, size_t memory_size)
         header_next = (header_t*)((char*)memory + header->next);
         header_next->next = header->next + sizeof(header_t) + block_size;
         header = header_next;
+        ++fsa->n_blocks;
     }
 
     header->next = 0;
+    fsa->n_free = fsa->n_blocks;
+    fsa->min_free = fsa->n_blocks;
+
+    return fsa;
+}
+
+size_t FSASuggestBitmapSize(size_t block_size, size_t n_blocks)
+{
+    block_size = AlignBlock(block_size);
+
+    return sizeof(fsa_t) + CountWords(n_blocks) * sizeof(bit_array_t)
+                                                    + block_size * n_blocks;
+}
+
+fsa_t* FSAInitBitmap(void* memory, size_t block_size, size_t memory_size)
+{
+    fsa_t* fsa = NULL;
+    size_t n_blocks = 0;
+    size_t index = 0;
+
+    assert(memory);
+
+    block_size = AlignBlock(block_size);
+
+    if(block_size == 0 || memory_size < sizeof(fsa_t))
+    {
+        return NULL;
+    }
+
+    /* every block also costs a bit */
+    n_blocks = (memory_size - sizeof(fsa_t)) * CHAR_BIT
+                                                / (block_size * CHAR_BIT + 1);
+
+    while(n_blocks > 0 &&
+            FSASuggestBitmapSize(block_size, n_blocks) > memory_size)
+    {
+        --n_blocks;
+    }
+
+    if(n_blocks == 0)
+    {
+        return NULL;
+    }
+
+    fsa = memory;
+    fsa->next_free = 0;
+    fsa->block_size = block_size;
+    fsa->n_blocks = n_blocks;
+    fsa->n_free = n_blocks;
+    fsa->min_free = n_blocks;
+    fsa->bitmap = (bit_array_t*)(fsa + 1);
+    fsa->n_words = CountWords(n_blocks);
+    fsa->first_word = 0;
+
+    for(; index < fsa->n_words; ++index)
+    {
+        fsa->bitmap[index] = BitArraySetAll(0);
+    }
+
+    /* the bits past the last block stay off */
+    if(n_blocks % WORD_BITS != 0)
+    {
+        fsa->bitmap[fsa->n_words - 1] = ((bit_array_t)1
+                                            << n_blocks % WORD_BITS) - 1;
+    }
 
     return fsa;
 }
@@ -63,11 +196,23 @@ void* FSAAlloc(fsa_t* fsa)
     
     assert(fsa);
 
-    if(fsa->next_free == 0)
+    if(fsa->n_free == 0)
     {
         return NULL;
     }
 
+    --fsa->n_free;
+
+    if(fsa->n_free < fsa->min_free)
+    {
+        fsa->min_free = fsa->n_free;
+    }
+
+    if(fsa->bitmap)
+    {
+        return AllocFromBitmap(fsa);
+    }
+
     header = (header_t*)((char*)fsa + fsa->next_free);
     fsa->next_free = header->next;
 
@@ -81,28 +226,115 @@ void FSAFree(fsa_t* fsa, void* p_block)
     assert(fsa);
     assert(p_block);
 
+    ++fsa->n_free;
+
+    if(fsa->bitmap)
+    {
+        FreeToBitmap(fsa, p_block);
+        return;
+    }
+
     header = (header_t*)p_block - 1;
     header->next = fsa->next_free;
     fsa->next_free = (size_t)header - (size_t)fsa;
 }
 
-size_t FSACountFree(const fsa_t* fsa)
+size_t FSAAllocBulk(fsa_t* fsa, void** blocks, size_t n_blocks)
 {
     header_t* header = NULL;
-    size_t count = 0;
     size_t offset = 0;
+    size_t index = 0;
 
     assert(fsa);
+    assert(blocks || n_blocks == 0);
 
-    offset = fsa->next_free;
-    
-    while(offset != 0)
+    n_blocks = n_blocks < fsa->n_free ? n_blocks : fsa->n_free;
+
+    if(fsa->bitmap)
+    {
+        for(; index < n_blocks; ++index)
+        {
+            blocks[index] = AllocFromBitmap(fsa);
+        }
+    }
+
+    /* the first @n_blocks of the list are detached at once */
+    else
+    {
+        offset = fsa->next_free;
+
+        for(; index < n_blocks; ++index)
+        {
+            header = (header_t*)((char*)fsa + offset);
+            blocks[index] = header + 1;
+            offset = header->next;
+        }
+
+        fsa->next_free = offset;
+    }
+
+    fsa->n_free -= n_blocks;
+
+    if(fsa->n_free < fsa->min_free)
+    {
+        fsa->min_free = fsa->n_free;
+    }
+
+    return n_blocks;
+}
+
+void FSAFreeBulk(fsa_t* fsa, void** blocks, size_t n_blocks)
+{
+    header_t* header = NULL;
+    size_t index = 0;
+
+    assert(fsa);
+    assert(blocks || n_blocks == 0);
+
+    if(n_blocks == 0)
+    {
+        return;
+    }
+
+    fsa->n_free += n_blocks;
+
+    if(fsa->bitmap)
+    {
+        for(; index < n_blocks; ++index)
+        {
+            FreeToBitmap(fsa, blocks[index]);
+        }
+
+        return;
+    }
+
+    /* the blocks are chained in order and attached at once */
+    for(; index < n_blocks - 1; ++index)
     {
-        header = (header_t*)((char*)fsa + offset);
-        offset = header->next;
-        ++count;
+        header = (header_t*)blocks[index] - 1;
+        header->next = (size_t)((header_t*)blocks[index + 1] - 1)
+                                                                - (size_t)fsa;
     }
 
-    return count;
+    header = (header_t*)blocks[n_blocks - 1] - 1;
+    header->next = fsa->next_free;
+    fsa->next_free = (size_t)((header_t*)blocks[0] - 1) - (size_t)fsa;
+}
+
+size_t FSACountFree(const fsa_t* fsa)
+{
+    assert(fsa);
+
+    return fsa->n_free;
 }
 
+void FSAGetStats(const fsa_t* fsa, fsa_stats_t* stats)
+{
+    assert(fsa);
+    assert(stats);
+
+    stats->block_size = fsa->block_size;
+    stats->blocks_in_use = fsa->n_blocks - fsa->n_free;
+    stats->peak_blocks_in_use = fsa->n_blocks - fsa->min_free;
+    stats->free_blocks = fsa->n_free;
+}
@@ -6,20 +6,60 @@
 
 #define CAPACITY (1024)
 #define ELEM_SIZE (sizeof(void*))
-#define GET_LEFT(index) (index * 2 + 1)
-#define GET_RIGHT(index) (GET_LEFT(index) + 1)
-#define GET_PARENT(index) ((index - 1) / 2)
-
+#define BINARY_ARITY (2)
+#define CACHE_LINE (64)
+#define GET_FIRST_CHILD(index, arity) ((index) * (arity) + 1)
+#define GET_PARENT(index, arity) (((index) - 1) / (arity))
+
+/*
+*   the vector starts with @arity - 1 unused slots, so the children of a node
+*   start at a multiple of @arity slots from the cache line aligned start of
+*   the vector
+*/
 struct heap {
     dvector_t* vector;
     compare_func_t compare_func;
+    size_t arity;
 };
 
-heap_t* HeapCreate(compare_func_t compare)
+static size_t GetSlot(const heap_t* heap, size_t index)
 {
-    heap_t* heap = NULL;
+    return index + heap->arity - 1;
+}
 
-    assert(compare);
+static size_t GetSize(const heap_t* heap)
+{
+    return DvectorSize(heap->vector) - (heap->arity - 1);
+}
+
+static void GetElement(const heap_t* heap, size_t index, void** data)
+{
+    DvectorGetElement(heap->vector, GetSlot(heap, index), data);
+}
+
+static void SetElement(heap_t* heap, size_t index, void** data)
+{
+    DvectorSetElement(heap->vector, GetSlot(heap, index), data);
+}
+
+/* the unused slots are pushed again within the capacity they had */
+static void ClearHeap(heap_t* heap)
+{
+    void* unused = NULL;
+    size_t index = 0;
+
+    DvectorClear(heap->vector);
+
+    for(; index < heap->arity - 1; ++index)
+    {
+        DvectorPushBack(heap->vector, &unused);
+    }
+}
+
+static heap_t* CreateHeap(compare_func_t compare, size_t arity,
+                                                            size_t capacity)
+{
+    heap_t* heap = NULL;
 
     heap = (heap_t*)malloc(sizeof(heap_t));
 
@@ -28,7 +68,8 @@ heap_t* HeapCreate(compare_func_t compare)
         return NULL;
     }
 
-    heap->vector = DvectorCreate(CAPACITY, ELEM_SIZE);
+    heap->vector = DvectorCreateAligned(capacity + arity - 1, ELEM_SIZE,
+                                                                CACHE_LINE);
 
     if(!heap->vector)
     {
@@ -37,10 +78,25 @@ heap_t* HeapCreate(compare_func_t compare)
     }
 
     heap->compare_func = compare;
+    heap->arity = arity;
+    ClearHeap(heap);
 
     return heap;
 }
 
+heap_t* HeapCreate(compare_func_t compare)
+{
+    return HeapCreateEx(compare, BINARY_ARITY);
+}
+
+heap_t* HeapCreateEx(compare_func_t compare, size_t arity)
+{
+    assert(compare);
+    assert(arity >= BINARY_ARITY);
+
+    return CreateHeap(compare, arity, CAPACITY);
+}
+
 void HeapDestroy(heap_t* heap)
 {
     assert(heap);
@@ -49,15 +105,15 @@ void HeapDestroy(heap_t* heap)
     free(heap);
 }
 
-static void Swap(dvector_t* vector, size_t index1, size_t index2)
+static void Swap(heap_t* heap, size_t index1, size_t index2)
 {
     void* p_index1 = NULL;
     void* p_index2 = NULL;
 
-    DvectorGetElement(vector, index1, &p_index1);
-    DvectorGetElement(vector, index2, &p_index2);
-    DvectorSetElement(vector, index1, &p_index2);
-    DvectorSetElement(vector, index2, &p_index1);
+    GetElement(heap, index1, &p_index1);
+    GetElement(heap, index2, &p_index2);
+    SetElement(heap, index1, &p_index2);
+    SetElement(heap, index2, &p_index1);
 }
 
 static void HeapifyUp(heap_t* heap, size_t index)
@@ -70,57 +126,174 @@ static void HeapifyUp(heap_t* heap, size_t index)
         return;
     }
 
-    DvectorGetElement(heap->vector, index, &child);
-    DvectorGetElement(heap->vector, GET_PARENT(index), &parent);
+    GetElement(heap, index, &child);
+    GetElement(heap, GET_PARENT(index, heap->arity), &parent);
 
     if(heap->compare_func(parent, child) > 0)
     {
-        Swap(heap->vector, index, GET_PARENT(index));
-        HeapifyUp(heap, GET_PARENT(index));
+        Swap(heap, index, GET_PARENT(index, heap->arity));
+        HeapifyUp(heap, GET_PARENT(index, heap->arity));
     }
 }
 
 static void HeapifyDown(heap_t* heap, size_t index)
 {
     size_t min_index = index;
-    void* left = NULL;
-    void* right = NULL;
-    void* parent = NULL;
+    size_t child_index = GET_FIRST_CHILD(index, heap->arity);
+    size_t last_child = child_index + heap->arity;
+    void* child = NULL;
     void* min_child = NULL;
 
-    if(GET_LEFT(index) >= DvectorSize(heap->vector))
+    if(child_index >= GetSize(heap))
     {
         return;
     }
 
-    DvectorGetElement(heap->vector, index, &parent);
-    DvectorGetElement(heap->vector, GET_LEFT(index), &left);
-        
-    if(GET_RIGHT(index) < DvectorSize(heap->vector))
+    if(last_child > GetSize(heap))
     {
-        DvectorGetElement(heap->vector, GET_RIGHT(index), &right);
+        last_child = GetSize(heap);
     }
 
-    min_child = parent;
+    GetElement(heap, index, &min_child);
 
-    if(heap->compare_func(left, min_child) < 0)
+    for(; child_index < last_child; ++child_index)
     {
-        min_child = left;
-        min_index = GET_LEFT(index);
-    }
+        GetElement(heap, child_index, &child);
 
-    if(right && heap->compare_func(right, min_child) < 0)
-    {
-        min_index = GET_RIGHT(index);
+        if(heap->compare_func(child, min_child) < 0)
+        {
+            min_child = child;
+            min_index = child_index;
+        }
     }
 
     if(min_index != index)
     {
-        Swap(heap->vector, index, min_index);
+        Swap(heap, index, min_index);
         HeapifyDown(heap, min_index);
     }  
 }
 
+static void BuildHeap(heap_t* heap)
+{
+    size_t index = GetSize(heap);
+
+    if(index < 2)
+    {
+        return;
+    }
+
+    index = GET_PARENT(index - 1, heap->arity) + 1;
+
+    while(index > 0)
+    {
+        --index;
+        HeapifyDown(heap, index);
+    }
+}
+
+static void FixAppended(heap_t* heap, size_t old_size)
+{
+    size_t index = old_size;
+    size_t new_size = GetSize(heap);
+
+    /* rebuilding is O(n + m), sifting up the new elements is O(m * log(n)) */
+    if(new_size - old_size > old_size)
+    {
+        BuildHeap(heap);
+        return;
+    }
+
+    for(; index < new_size; ++index)
+    {
+        HeapifyUp(heap, index);
+    }
+}
+
+heap_t* HeapCreateFrom(compare_func_t compare, void** array, size_t n_elements)
+{
+    heap_t* heap = NULL;
+
+    assert(compare);
+    assert(array || n_elements == 0);
+
+    heap = CreateHeap(compare, BINARY_ARITY,
+                                n_elements > CAPACITY ? n_elements : CAPACITY);
+
+    if(!heap)
+    {
+        return NULL;
+    }
+
+    if(DvectorPushBackMany(heap->vector, array, n_elements))
+    {
+        HeapDestroy(heap);
+        return NULL;
+    }
+
+    BuildHeap(heap);
+
+    return heap;
+}
+
+int HeapMerge(heap_t* dst, heap_t* src)
+{
+    size_t dst_size = 0;
+    size_t src_size = 0;
+    size_t index = 0;
+    void* data = NULL;
+
+    assert(dst);
+    assert(src);
+    assert(dst != src);
+
+    dst_size = GetSize(dst);
+    src_size = GetSize(src);
+
+    if(DvectorSize(dst->vector) + src_size > DvectorCapacity(dst->vector) &&
+            DvectorResize(dst->vector, DvectorSize(dst->vector) + src_size))
+    {
+        return 1;
+    }
+
+    for(index = 0; index < src_size; ++index)
+    {
+        GetElement(src, index, &data);
+        DvectorPushBack(dst->vector, &data);
+    }
+
+    ClearHeap(src);
+    FixAppended(dst, dst_size);
+
+    return 0;
+}
+
+int HeapPushMany(heap_t* heap, void** array, size_t n_elements)
+{
+    size_t old_size = 0;
+
+    assert(heap);
+    assert(array || n_elements == 0);
+
+    old_size = GetSize(heap);
+
+    if(DvectorPushBackMany(heap->vector, array, n_elements))
+    {
+        return 1;
+    }
+
+    FixAppended(heap, old_size);
+
+    return 0;
+}
+
+void HeapClear(heap_t* heap)
+{
+    assert(heap);
+
+    ClearHeap(heap);
+}
+
 int HeapPush(heap_t* heap, void* data)
 {
     assert(heap);
@@ -130,7 +303,7 @@ int HeapPush(heap_t* heap, void* data)
         return 1;
     }
 
-    HeapifyUp(heap, DvectorSize(heap->vector) - 1);
+    HeapifyUp(heap, GetSize(heap) - 1);
 
     return 0;
 }
@@ -140,7 +313,7 @@ int HeapPop(heap_t* heap)
     assert(heap);
     assert(!HeapIsEmpty(heap));
 
-    Swap(heap->vector, 0, DvectorSize(heap->vector) - 1);
+    Swap(heap, 0, GetSize(heap) - 1);
 
     if(DvectorPopBack(heap->vector))
     {
@@ -159,30 +332,41 @@ static void* FindElementToRemove(heap_t* heap, void* param,
                                             is_match_t is_match, size_t index)
 {
     void* index_data = NULL;
+    size_t child_index = GET_FIRST_CHILD(index, heap->arity);
+    size_t last_child = child_index + heap->arity;
 
-    if(index >= DvectorSize(heap->vector))
+    if(index >= GetSize(heap))
     {
         return NULL;
     }
 
-    DvectorGetElement(heap->vector, index, &index_data);
+    GetElement(heap, index, &index_data);
 
     if(is_match(index_data, param))
     {
-        Swap(heap->vector, index, DvectorSize(heap->vector) - 1);
+        Swap(heap, index, GetSize(heap) - 1);
         DvectorPopBack(heap->vector);
-        HeapifyDown(heap, index);
+
+        if(index < GetSize(heap))
+        {
+            HeapifyUp(heap, index);
+            HeapifyDown(heap, index);
+        }
+
         return index_data;
     }
 
-    index_data = FindElementToRemove(heap, param, is_match, GET_LEFT(index));
-
-    if(index_data)
+    for(; child_index < last_child; ++child_index)
     {
-        return index_data;
+        index_data = FindElementToRemove(heap, param, is_match, child_index);
+
+        if(index_data)
+        {
+            return index_data;
+        }
     }
 
-    return FindElementToRemove(heap, param, is_match, GET_RIGHT(index));
+    return NULL;
 }
 
 void* HeapRemove(heap_t* heap, void* param, is_match_t is_match)
@@ -197,14 +381,14 @@ size_t HeapSize(const heap_t* heap)
 {
     assert(heap);
 
-    return DvectorSize(heap->vector);
+    return GetSize(heap);
 }
 
 int HeapIsEmpty(const heap_t* heap)
 {
     assert(heap);
 
-    return DvectorSize(heap->vector) == 0;
+    return GetSize(heap) == 0;
 }
 
 void* HeapPeek(const heap_t* heap)
@@ -214,7 +398,7 @@ void* HeapPeek(const heap_t* heap)
     assert(heap);
     assert(!HeapIsEmpty(heap));
 
-    DvectorGetElement(heap->vector, 0, &dst);
+    GetElement(heap, 0, &dst);
 
     return dst;
 }
@@ -48,6 +48,13 @@ int PQEnqueue(heap_pq_t* pq, void* data)
     return HeapPush(pq->heap, data);
 }
 
+int PQEnqueueMany(heap_pq_t* pq, void** data, size_t n_elements)
+{
+    assert(pq);
+    
+    return HeapPushMany(pq->heap, data, n_elements);
+}
+
 void* PQDequeue(heap_pq_t* pq)
 {
     void* peek = NULL;
@@ -61,6 +68,22 @@ void* PQDequeue(heap_pq_t* pq)
     return peek;
 }
 
+size_t PQDequeueMany(heap_pq_t* pq, void** out, size_t k)
+{
+    size_t count = 0;
+
+    assert(pq);
+    assert(out || k == 0);
+
+    for(; count < k && !PQIsEmpty(pq); ++count)
+    {
+        out[count] = HeapPeek(pq->heap);
+        HeapPop(pq->heap);
+    }
+
+    return count;
+}
+
 void* PQPeek(const heap_pq_t* pq)
 {
     assert(pq);
@@ -87,10 +110,7 @@ void PQClear(heap_pq_t* pq)
 {
     assert(pq);
     
-    while(!PQIsEmpty(pq))
-    {
-        PQDequeue(pq);
-    }
+    HeapClear(pq->heap);
 }
 
 void* PQErase(heap_pq_t* pq, int (*is_match)(const void*, const void*),
@@ -101,3 +121,40 @@ void* PQErase(heap_pq_t* pq, int (*is_match)(const void*, const void*),
 
     return HeapRemove(pq->heap, (void*)param, is_match);
 }
+
+void** PQTopK(void** array, size_t n_elements, size_t k,
+                                int (*compare_func)(const void*, const void*))
+{
+    heap_t* heap = NULL;
+    void** top = NULL;
+    size_t index = 0;
+
+    assert(array || n_elements == 0);
+    assert(compare_func);
+
+    k = k < n_elements ? k : n_elements;
+    top = (void**)malloc((k ? k : 1) * sizeof(void*));
+
+    if(top == NULL)
+    {
+        return NULL;
+    }
+
+    heap = HeapCreateFrom(compare_func, array, n_elements);
+
+    if(heap == NULL)
+    {
+        free(top);
+        return NULL;
+    }
+
+    for(; index < k; ++index)
+    {
+        top[index] = HeapPeek(heap);
+        HeapPop(heap);
+    }
+
+    HeapDestroy(heap);
+
+    return top;
+}
@@ -0,0 +1,261 @@
+#include <assert.h>      /*assert*/
+#include <stdlib.h>      /*malloc, free*/
+
+#include "interval_tree.h"
+
+#define MAX(a,b) (a > b ? a : b)
+
+struct it_node {
+    long low;
+    long high;
+    long max_high;      /* highest @high in the subtree */
+    void* data;
+    struct it_node* left;
+    struct it_node* right;
+    struct it_node* parent;
+    size_t height;
+};
+
+/* the root of the tree is the left child of @dummy */
+struct interval_tree {
+    it_node_t dummy;
+    size_t size;
+};
+
+static it_node_t* GetRoot(const interval_tree_t* tree)
+{
+    return tree->dummy.left;
+}
+
+static void DestroyNodes(it_node_t* node)
+{
+    if(!node)
+    {
+        return;
+    }
+
+    DestroyNodes(node->left);
+    DestroyNodes(node->right);
+    free(node);
+}
+
+static void UpdateMaxHigh(it_node_t* node)
+{
+    node->max_high = node->high;
+
+    if(node->left)
+    {
+        node->max_high = MAX(node->max_high, node->left->max_high);
+    }
+
+    if(node->right)
+    {
+        node->max_high = MAX(node->max_high, node->right->max_high);
+    }
+}
+
+#define AVL_NODE it_node_t
+#define AVL_UPDATE UpdateMaxHigh
+#include "avl_balance.h"
+
+static int IsOverlapping(const it_node_t* node, long low, long high)
+{
+    return node->low <= high && low <= node->high;
+}
+
+static int ForEachOverlap(const it_node_t* node, long low, long high,
+                                    action_func_t action_func, void* param)
+{
+    int action_result = 0;
+
+    /* nothing in this subtree reaches @low */
+    if(!node || node->max_high < low)
+    {
+        return 0;
+    }
+
+    action_result = ForEachOverlap(node->left, low, high, action_func, param);
+
+    if(action_result != 0)
+    {
+        return action_result;
+    }
+
+    /* this node and its right subtree start after @high */
+    if(node->low > high)
+    {
+        return 0;
+    }
+
+    if(node->high >= low)
+    {
+        action_result = action_func(node->data, param);
+
+        if(action_result != 0)
+        {
+            return action_result;
+        }
+    }
+
+    return ForEachOverlap(node->right, low, high, action_func, param);
+}
+
+/*****************************************************************************/
+
+interval_tree_t* ITCreate(void)
+{
+    interval_tree_t* tree = NULL;
+    it_node_t dummy = {0};
+
+    tree = (interval_tree_t*)malloc(sizeof(interval_tree_t));
+
+    if(!tree)
+    {
+        return NULL;
+    }
+
+    tree->dummy = dummy;
+    tree->size = 0;
+
+    return tree;
+}
+
+void ITDestroy(interval_tree_t* tree)
+{
+    assert(tree);
+
+    DestroyNodes(GetRoot(tree));
+    free(tree);
+}
+
+it_node_t* ITInsert(interval_tree_t* tree, long low, long high, void* data)
+{
+    it_node_t* node = NULL;
+    it_node_t* parent = &tree->dummy;
+    it_node_t** link = &tree->dummy.left;
+
+    assert(tree);
+    assert(low <= high);
+
+    node = (it_node_t*)malloc(sizeof(it_node_t));
+
+    if(!node)
+    {
+        return NULL;
+    }
+
+    /* equal low endpoints go right, after the ones already inserted */
+    while(*link)
+    {
+        parent = *link;
+        link = low < parent->low ? &parent->left : &parent->right;
+    }
+
+    node->low = low;
+    node->high = high;
+    node->max_high = high;
+    node->data = data;
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = parent;
+    node->height = 1;
+    *link = node;
+    ++tree->size;
+
+    Retrace(parent, &tree->dummy);
+
+    return node;
+}
+
+void* ITRemove(interval_tree_t* tree, it_node_t* node)
+{
+    it_node_t* start = NULL;
+    void* data = NULL;
+
+    assert(tree);
+    assert(node);
+
+    if(node->left && node->right)
+    {
+        start = ReplaceWithSuccessor(node);
+    }
+
+    else
+    {
+        start = node->parent;
+        ReplaceChild(node->parent, node, node->left ? node->left : node->right);
+    }
+
+    data = node->data;
+    free(node);
+    --tree->size;
+
+    Retrace(start, &tree->dummy);
+
+    return data;
+}
+
+it_node_t* ITFindAny(const interval_tree_t* tree, long low, long high)
+{
+    it_node_t* node = NULL;
+
+    assert(tree);
+
+    node = GetRoot(tree);
+
+    /*
+    *   if the left subtree reaches @low but holds no overlap, every interval
+    *   in it starts after @high, and so does every one on the right
+    */
+    while(node && !IsOverlapping(node, low, high))
+    {
+        node = node->left && node->left->max_high >= low ? node->left :
+                                                                node->right;
+    }
+
+    return node;
+}
+
+int ITForEachOverlap(const interval_tree_t* tree, long low, long high,
+                                    action_func_t action_func, void* param)
+{
+    assert(tree);
+    assert(action_func);
+
+    return ForEachOverlap(GetRoot(tree), low, high, action_func, param);
+}
+
+void* ITGetData(const it_node_t* node)
+{
+    assert(node);
+
+    return node->data;
+}
+
+long ITGetLow(const it_node_t* node)
+{
+    assert(node);
+
+    return node->low;
+}
+
+long ITGetHigh(const it_node_t* node)
+{
+    assert(node);
+
+    return node->high;
+}
+
+size_t ITGetSize(const interval_tree_t* tree)
+{
+    assert(tree);
+
+    return tree->size;
+}
+
+int ITIsEmpty(const interval_tree_t* tree)
+{
+    assert(tree);
+
+    return GetRoot(tree) == NULL;
+}
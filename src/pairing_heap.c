@@ -0,0 +1,292 @@
+#include <stdlib.h>     /*malloc, free*/
+#include <assert.h>     /* assert */
+
+#include "pairing_heap.h"
+
+/*
+*   Children of a node are kept in a list through @sibling. @prev points to the
+*   parent for the first child and to the previous sibling for the others.
+*/
+struct ph_node {
+    void* data;
+    ph_node_t* child;
+    ph_node_t* sibling;
+    ph_node_t* prev;
+};
+
+struct pairing_heap {
+    ph_node_t* root;
+    compare_func_t compare_func;
+    size_t size;
+};
+
+static ph_node_t* Link(pairing_heap_t* heap, ph_node_t* first,
+                                                            ph_node_t* second)
+{
+    ph_node_t* temp = NULL;
+
+    if(!first)
+    {
+        return second;
+    }
+
+    if(!second)
+    {
+        return first;
+    }
+
+    if(heap->compare_func(second->data, first->data) < 0)
+    {
+        temp = first;
+        first = second;
+        second = temp;
+    }
+
+    second->sibling = first->child;
+    second->prev = first;
+
+    if(first->child)
+    {
+        first->child->prev = second;
+    }
+
+    first->child = second;
+    first->sibling = NULL;
+    first->prev = NULL;
+
+    return first;
+}
+
+static ph_node_t* MergePairs(pairing_heap_t* heap, ph_node_t* first)
+{
+    ph_node_t* pairs = NULL;
+    ph_node_t* second = NULL;
+    ph_node_t* next = NULL;
+
+    /* left to right: link siblings in pairs, keeping the results reversed */
+    while(first)
+    {
+        second = first->sibling;
+        next = second ? second->sibling : NULL;
+        first->sibling = NULL;
+
+        if(second)
+        {
+            second->sibling = NULL;
+            first = Link(heap, first, second);
+        }
+
+        first->sibling = pairs;
+        pairs = first;
+        first = next;
+    }
+
+    /* right to left: link every pair into the accumulated result */
+    first = pairs;
+    pairs = pairs ? pairs->sibling : NULL;
+
+    while(pairs)
+    {
+        next = pairs->sibling;
+        pairs->sibling = NULL;
+        first = Link(heap, first, pairs);
+        pairs = next;
+    }
+
+    return first;
+}
+
+static void Detach(ph_node_t* node)
+{
+    if(node->prev->child == node)
+    {
+        node->prev->child = node->sibling;
+    }
+
+    else
+    {
+        node->prev->sibling = node->sibling;
+    }
+
+    if(node->sibling)
+    {
+        node->sibling->prev = node->prev;
+    }
+
+    node->sibling = NULL;
+    node->prev = NULL;
+}
+
+pairing_heap_t* PairingHeapCreate(compare_func_t compare_func)
+{
+    pairing_heap_t* heap = NULL;
+
+    assert(compare_func);
+
+    heap = (pairing_heap_t*)malloc(sizeof(pairing_heap_t));
+
+    if(!heap)
+    {
+        return NULL;
+    }
+
+    heap->root = NULL;
+    heap->compare_func = compare_func;
+    heap->size = 0;
+
+    return heap;
+}
+
+void PairingHeapDestroy(pairing_heap_t* heap)
+{
+    ph_node_t* list = NULL;
+    ph_node_t* node = NULL;
+    ph_node_t* tail = NULL;
+
+    assert(heap);
+
+    list = heap->root;
+
+    while(list)
+    {
+        node = list;
+        list = node->sibling;
+
+        if(node->child)
+        {
+            tail = node->child;
+
+            while(tail->sibling)
+            {
+                tail = tail->sibling;
+            }
+
+            tail->sibling = list;
+            list = node->child;
+        }
+
+        free(node);
+    }
+
+    free(heap);
+}
+
+ph_node_t* PairingHeapPush(pairing_heap_t* heap, void* data)
+{
+    ph_node_t* node = NULL;
+
+    assert(heap);
+
+    node = (ph_node_t*)malloc(sizeof(ph_node_t));
+
+    if(!node)
+    {
+        return NULL;
+    }
+
+    node->data = data;
+    node->child = NULL;
+    node->sibling = NULL;
+    node->prev = NULL;
+    heap->root = Link(heap, heap->root, node);
+    ++heap->size;
+
+    return node;
+}
+
+void* PairingHeapPop(pairing_heap_t* heap)
+{
+    ph_node_t* root = NULL;
+    void* data = NULL;
+
+    assert(heap);
+    assert(!PairingHeapIsEmpty(heap));
+
+    root = heap->root;
+    data = root->data;
+    heap->root = MergePairs(heap, root->child);
+
+    if(heap->root)
+    {
+        heap->root->prev = NULL;
+    }
+
+    free(root);
+    --heap->size;
+
+    return data;
+}
+
+void* PairingHeapPeek(const pairing_heap_t* heap)
+{
+    assert(heap);
+    assert(!PairingHeapIsEmpty(heap));
+
+    return heap->root->data;
+}
+
+void PairingHeapDecreaseKey(pairing_heap_t* heap, ph_node_t* node, void* data)
+{
+    assert(heap);
+    assert(node);
+    assert(heap->compare_func(data, node->data) <= 0);
+
+    node->data = data;
+
+    if(node == heap->root)
+    {
+        return;
+    }
+
+    Detach(node);
+    heap->root = Link(heap, heap->root, node);
+}
+
+void* PairingHeapRemove(pairing_heap_t* heap, ph_node_t* node)
+{
+    ph_node_t* subtree = NULL;
+    void* data = NULL;
+
+    assert(heap);
+    assert(node);
+
+    if(node == heap->root)
+    {
+        return PairingHeapPop(heap);
+    }
+
+    data = node->data;
+    Detach(node);
+    subtree = MergePairs(heap, node->child);
+    heap->root = Link(heap, heap->root, subtree);
+    free(node);
+    --heap->size;
+
+    return data;
+}
+
+void PairingHeapMerge(pairing_heap_t* dst, pairing_heap_t* src)
+{
+    assert(dst);
+    assert(src);
+    assert(dst != src);
+
+    dst->root = Link(dst, dst->root, src->root);
+    dst->size += src->size;
+    src->root = NULL;
+    src->size = 0;
+}
+
+size_t PairingHeapSize(const pairing_heap_t* heap)
+{
+    assert(heap);
+
+    return heap->size;
+}
+
+int PairingHeapIsEmpty(const pairing_heap_t* heap)
+{
+    assert(heap);
+
+    return heap->root == NULL;
+}
@@ -0,0 +1,535 @@
+#define _POSIX_C_SOURCE 200112L     /* pthread */
+
+#include <stdlib.h>                  /* malloc, free */
+#include <assert.h>                  /* assert */
+#include <pthread.h>                 /* pthread_mutex_t */
+
+#include "persistent_avl.h"
+
+typedef struct pavl_node
+{
+    void* data;
+    struct pavl_node* left;
+    struct pavl_node* right;
+    size_t height;
+    size_t refs;
+} pavl_node_t;
+
+struct pavl
+{
+    compare_func_t compare_func;
+    pavl_node_t* root;
+    size_t size;
+    size_t refs;
+};
+
+struct pavl_root
+{
+    pthread_mutex_t lock;
+    pavl_t* version;
+};
+
+#ifndef __GNUC__
+static pthread_mutex_t g_refs_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void IncRefs(size_t* refs)
+{
+#ifdef __GNUC__
+    __sync_add_and_fetch(refs, 1);
+#else
+    pthread_mutex_lock(&g_refs_lock);
+    ++*refs;
+    pthread_mutex_unlock(&g_refs_lock);
+#endif
+}
+
+/* returns the number of references left */
+static size_t DecRefs(size_t* refs)
+{
+#ifdef __GNUC__
+    return __sync_sub_and_fetch(refs, 1);
+#else
+    size_t left = 0;
+
+    pthread_mutex_lock(&g_refs_lock);
+    left = --*refs;
+    pthread_mutex_unlock(&g_refs_lock);
+
+    return left;
+#endif
+}
+
+static pavl_node_t* Retain(pavl_node_t* node)
+{
+    if(node)
+    {
+        IncRefs(&node->refs);
+    }
+
+    return node;
+}
+
+static void Release(pavl_node_t* node)
+{
+    if(node && DecRefs(&node->refs) == 0)
+    {
+        Release(node->left);
+        Release(node->right);
+        free(node);
+    }
+}
+
+static size_t GetHeight(const pavl_node_t* node)
+{
+    return node ? node->height : 0;
+}
+
+/* the new node holds its own reference to each child */
+static pavl_node_t* CreateNode(void* data, pavl_node_t* left,
+                                                        pavl_node_t* right)
+{
+    pavl_node_t* node = NULL;
+    size_t left_height = GetHeight(left);
+    size_t right_height = GetHeight(right);
+
+    node = (pavl_node_t*)malloc(sizeof(pavl_node_t));
+
+    if(node == NULL)
+    {
+        return NULL;
+    }
+
+    node->data = data;
+    node->left = Retain(left);
+    node->right = Retain(right);
+    node->height = 1 + (left_height > right_height ? left_height :
+                                                                right_height);
+    node->refs = 1;
+
+    return node;
+}
+
+/* single rotation, @outer stays a child of the new top @top_data and the
+   old top @data moves down to the other side with @inner and @other */
+static pavl_node_t* CreateRotated(void* top_data, pavl_node_t* outer,
+            void* data, pavl_node_t* inner, pavl_node_t* other, int is_right)
+{
+    pavl_node_t* child = NULL;
+    pavl_node_t* node = NULL;
+
+    child = is_right ? CreateNode(data, inner, other) :
+                                            CreateNode(data, other, inner);
+
+    if(child == NULL)
+    {
+        return NULL;
+    }
+
+    node = is_right ? CreateNode(top_data, outer, child) :
+                                            CreateNode(top_data, child, outer);
+    Release(child);
+
+    return node;
+}
+
+static pavl_node_t* CreateDoubleRotated(pavl_node_t* middle, void* left_data,
+        pavl_node_t* left, void* right_data, pavl_node_t* right)
+{
+    pavl_node_t* new_left = NULL;
+    pavl_node_t* new_right = NULL;
+    pavl_node_t* node = NULL;
+
+    new_left = CreateNode(left_data, left, middle->left);
+    new_right = CreateNode(right_data, middle->right, right);
+
+    if(new_left && new_right)
+    {
+        node = CreateNode(middle->data, new_left, new_right);
+    }
+
+    Release(new_left);
+    Release(new_right);
+
+    return node;
+}
+
+/* creates a balanced node of @data, @left and @right, whose heights differ
+   by two at most */
+static pavl_node_t* CreateBalanced(void* data, pavl_node_t* left,
+                                                        pavl_node_t* right)
+{
+    size_t left_height = GetHeight(left);
+    size_t right_height = GetHeight(right);
+
+    if(left_height > right_height + 1)
+    {
+        if(GetHeight(left->left) >= GetHeight(left->right))
+        {
+            return CreateRotated(left->data, left->left, data, left->right,
+                                                                    right, 1);
+        }
+
+        return CreateDoubleRotated(left->right, left->data, left->left, data,
+                                                                        right);
+    }
+
+    if(right_height > left_height + 1)
+    {
+        if(GetHeight(right->right) >= GetHeight(right->left))
+        {
+            return CreateRotated(right->data, right->right, data, right->left,
+                                                                    left, 0);
+        }
+
+        return CreateDoubleRotated(right->left, data, left, right->data,
+                                                                right->right);
+    }
+
+    return CreateNode(data, left, right);
+}
+
+/* creates the copy of @node with @new_left or @new_right in place of its
+   child and drops the caller's reference to the new child */
+static pavl_node_t* ReplaceLeft(pavl_node_t* node, pavl_node_t* new_left)
+{
+    pavl_node_t* copy = CreateBalanced(node->data, new_left, node->right);
+
+    Release(new_left);
+
+    return copy;
+}
+
+static pavl_node_t* ReplaceRight(pavl_node_t* node, pavl_node_t* new_right)
+{
+    pavl_node_t* copy = CreateBalanced(node->data, node->left, new_right);
+
+    Release(new_right);
+
+    return copy;
+}
+
+static pavl_node_t* InsertNode(const pavl_t* version, pavl_node_t* node,
+                                                            const void* data)
+{
+    pavl_node_t* child = NULL;
+    int compare_result = 0;
+
+    if(node == NULL)
+    {
+        return CreateNode((void*)data, NULL, NULL);
+    }
+
+    compare_result = version->compare_func(node->data, data);
+    assert(compare_result != 0);
+
+    child = InsertNode(version, compare_result > 0 ? node->left : node->right,
+                                                                        data);
+
+    if(child == NULL)
+    {
+        return NULL;
+    }
+
+    return compare_result > 0 ? ReplaceLeft(node, child) :
+                                                    ReplaceRight(node, child);
+}
+
+/* returns non zero on allocation failure, the new subtree in @out */
+static int RemoveMin(pavl_node_t* node, void** min_data, pavl_node_t** out)
+{
+    pavl_node_t* child = NULL;
+
+    if(node->left == NULL)
+    {
+        *min_data = node->data;
+        *out = Retain(node->right);
+
+        return 0;
+    }
+
+    if(RemoveMin(node->left, min_data, &child))
+    {
+        return 1;
+    }
+
+    *out = ReplaceLeft(node, child);
+
+    return *out == NULL;
+}
+
+/* the element matching @param must be in the subtree of @node */
+static int RemoveNode(const pavl_t* version, pavl_node_t* node,
+                                        const void* param, pavl_node_t** out)
+{
+    pavl_node_t* child = NULL;
+    void* min_data = NULL;
+    int compare_result = version->compare_func(node->data, param);
+
+    if(compare_result != 0)
+    {
+        if(RemoveNode(version, compare_result > 0 ? node->left : node->right,
+                                                            param, &child))
+        {
+            return 1;
+        }
+
+        *out = compare_result > 0 ? ReplaceLeft(node, child) :
+                                                    ReplaceRight(node, child);
+
+        return *out == NULL;
+    }
+
+    if(node->left == NULL || node->right == NULL)
+    {
+        *out = Retain(node->left ? node->left : node->right);
+
+        return 0;
+    }
+
+    if(RemoveMin(node->right, &min_data, &child))
+    {
+        return 1;
+    }
+
+    *out = CreateBalanced(min_data, node->left, child);
+    Release(child);
+
+    return *out == NULL;
+}
+
+static pavl_t* CreateVersion(compare_func_t compare_func, pavl_node_t* root,
+                                                                size_t size)
+{
+    pavl_t* version = (pavl_t*)malloc(sizeof(pavl_t));
+
+    if(version == NULL)
+    {
+        return NULL;
+    }
+
+    version->compare_func = compare_func;
+    version->root = root;
+    version->size = size;
+    version->refs = 1;
+
+    return version;
+}
+
+static int InOrderForEach(pavl_node_t* node, action_func_t action_func,
+                                                                    void* param)
+{
+    int action_result = 0;
+
+    if(!node)
+    {
+        return 0;
+    }
+
+    action_result = InOrderForEach(node->left, action_func, param);
+
+    if(action_result != 0)
+    {
+        return action_result;
+    }
+
+    action_result = action_func(node->data, param);
+
+    if(action_result != 0)
+    {
+        return action_result;
+    }
+
+    return InOrderForEach(node->right, action_func, param);
+}
+
+/*****************************************************************************/
+
+pavl_t* PAVLCreate(compare_func_t compare_func)
+{
+    assert(compare_func);
+
+    return CreateVersion(compare_func, NULL, 0);
+}
+
+void PAVLDestroy(pavl_t* version)
+{
+    assert(version);
+
+    if(DecRefs(&version->refs) == 0)
+    {
+        Release(version->root);
+        free(version);
+    }
+}
+
+pavl_t* PAVLAcquire(pavl_t* version)
+{
+    assert(version);
+
+    IncRefs(&version->refs);
+
+    return version;
+}
+
+pavl_t* PAVLInsert(const pavl_t* version, const void* data)
+{
+    pavl_node_t* root = NULL;
+    pavl_t* new_version = NULL;
+
+    assert(version);
+
+    root = InsertNode(version, version->root, data);
+
+    if(root == NULL)
+    {
+        return NULL;
+    }
+
+    new_version = CreateVersion(version->compare_func, root,
+                                                        version->size + 1);
+
+    if(new_version == NULL)
+    {
+        Release(root);
+    }
+
+    return new_version;
+}
+
+pavl_t* PAVLRemove(const pavl_t* version, const void* param)
+{
+    pavl_node_t* root = NULL;
+    pavl_t* new_version = NULL;
+
+    assert(version);
+
+    if(PAVLFind(version, param) == NULL)
+    {
+        return CreateVersion(version->compare_func, Retain(version->root),
+                                                                version->size);
+    }
+
+    if(RemoveNode(version, version->root, param, &root))
+    {
+        return NULL;
+    }
+
+    new_version = CreateVersion(version->compare_func, root,
+                                                        version->size - 1);
+
+    if(new_version == NULL)
+    {
+        Release(root);
+    }
+
+    return new_version;
+}
+
+void* PAVLFind(const pavl_t* version, const void* param)
+{
+    pavl_node_t* node = NULL;
+    int compare_result = 0;
+
+    assert(version);
+
+    node = version->root;
+
+    while(node)
+    {
+        compare_result = version->compare_func(node->data, param);
+
+        if(compare_result == 0)
+        {
+            return node->data;
+        }
+
+        node = compare_result > 0 ? node->left : node->right;
+    }
+
+    return NULL;
+}
+
+int PAVLForEach(const pavl_t* version, action_func_t action_func, void* param)
+{
+    assert(version);
+    assert(action_func);
+
+    return InOrderForEach(version->root, action_func, param);
+}
+
+size_t PAVLGetSize(const pavl_t* version)
+{
+    assert(version);
+
+    return version->size;
+}
+
+int PAVLIsEmpty(const pavl_t* version)
+{
+    assert(version);
+
+    return version->root == NULL;
+}
+
+pavl_root_t* PAVLRootCreate(pavl_t* version)
+{
+    pavl_root_t* root = NULL;
+
+    assert(version);
+
+    root = (pavl_root_t*)malloc(sizeof(pavl_root_t));
+
+    if(root == NULL)
+    {
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&root->lock, NULL) != 0)
+    {
+        free(root);
+        return NULL;
+    }
+
+    root->version = version;
+
+    return root;
+}
+
+void PAVLRootDestroy(pavl_root_t* root)
+{
+    assert(root);
+
+    PAVLDestroy(root->version);
+    pthread_mutex_destroy(&root->lock);
+    free(root);
+}
+
+pavl_t* PAVLRootLoad(pavl_root_t* root)
+{
+    pavl_t* version = NULL;
+
+    assert(root);
+
+    /* the reference is taken before a store may release the version */
+    pthread_mutex_lock(&root->lock);
+    version = PAVLAcquire(root->version);
+    pthread_mutex_unlock(&root->lock);
+
+    return version;
+}
+
+void PAVLRootStore(pavl_root_t* root, pavl_t* version)
+{
+    pavl_t* old_version = NULL;
+
+    assert(root);
+    assert(version);
+
+    pthread_mutex_lock(&root->lock);
+    old_version = root->version;
+    root->version = version;
+    pthread_mutex_unlock(&root->lock);
+
+    PAVLDestroy(old_version);
+}
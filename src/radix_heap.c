@@ -0,0 +1,214 @@
+#include <stdlib.h>     /*malloc, free*/
+#include <assert.h>     /* assert */
+#include <limits.h>     /* CHAR_BIT */
+
+#include "radix_heap.h"
+
+#define N_BUCKETS (sizeof(size_t) * CHAR_BIT + 1)
+
+typedef struct rh_node {
+    size_t key;
+    void* data;
+    struct rh_node* next;
+} rh_node_t;
+
+/*
+*   Bucket zero holds the keys equal to @last, bucket i holds the keys whose
+*   highest bit that differs from @last is bit i - 1.
+*/
+struct radix_heap {
+    size_t last;
+    size_t size;
+    rh_node_t* buckets[N_BUCKETS];
+};
+
+static size_t GetBucket(size_t key, size_t last)
+{
+    size_t diff = key ^ last;
+    size_t bucket = 0;
+
+    while(diff)
+    {
+        ++bucket;
+        diff >>= 1;
+    }
+
+    return bucket;
+}
+
+static void PushToBucket(radix_heap_t* heap, rh_node_t* node)
+{
+    size_t bucket = GetBucket(node->key, heap->last);
+
+    node->next = heap->buckets[bucket];
+    heap->buckets[bucket] = node;
+}
+
+static void Redistribute(radix_heap_t* heap)
+{
+    size_t bucket = 1;
+    rh_node_t* node = NULL;
+    rh_node_t* next = NULL;
+
+    if(heap->buckets[0])
+    {
+        return;
+    }
+
+    while(!heap->buckets[bucket])
+    {
+        ++bucket;
+    }
+
+    node = heap->buckets[bucket];
+    heap->last = node->key;
+
+    for(; node; node = node->next)
+    {
+        heap->last = node->key < heap->last ? node->key : heap->last;
+    }
+
+    /* every key of the bucket moves to a lower one relative to the new @last */
+    node = heap->buckets[bucket];
+    heap->buckets[bucket] = NULL;
+
+    while(node)
+    {
+        next = node->next;
+        PushToBucket(heap, node);
+        node = next;
+    }
+}
+
+radix_heap_t* RadixHeapCreate(void)
+{
+    radix_heap_t* heap = NULL;
+    size_t bucket = 0;
+
+    heap = (radix_heap_t*)malloc(sizeof(radix_heap_t));
+
+    if(!heap)
+    {
+        return NULL;
+    }
+
+    heap->last = 0;
+    heap->size = 0;
+
+    for(bucket = 0; bucket < N_BUCKETS; ++bucket)
+    {
+        heap->buckets[bucket] = NULL;
+    }
+
+    return heap;
+}
+
+void RadixHeapDestroy(radix_heap_t* heap)
+{
+    size_t bucket = 0;
+    rh_node_t* node = NULL;
+    rh_node_t* next = NULL;
+
+    assert(heap);
+
+    for(bucket = 0; bucket < N_BUCKETS; ++bucket)
+    {
+        for(node = heap->buckets[bucket]; node; node = next)
+        {
+            next = node->next;
+            free(node);
+        }
+    }
+
+    free(heap);
+}
+
+int RadixHeapPush(radix_heap_t* heap, size_t key, void* data)
+{
+    rh_node_t* node = NULL;
+
+    assert(heap);
+    assert(key >= heap->last);
+
+    node = (rh_node_t*)malloc(sizeof(rh_node_t));
+
+    if(!node)
+    {
+        return 1;
+    }
+
+    node->key = key;
+    node->data = data;
+    PushToBucket(heap, node);
+    ++heap->size;
+
+    return 0;
+}
+
+void* RadixHeapPop(radix_heap_t* heap, size_t* key)
+{
+    rh_node_t* node = NULL;
+    void* data = NULL;
+
+    assert(heap);
+    assert(!RadixHeapIsEmpty(heap));
+
+    Redistribute(heap);
+    node = heap->buckets[0];
+    heap->buckets[0] = node->next;
+    data = node->data;
+
+    if(key)
+    {
+        *key = node->key;
+    }
+
+    free(node);
+    --heap->size;
+
+    return data;
+}
+
+/* the smallest key is in the lowest bucket in use, @last is left to pop */
+void* RadixHeapPeek(const radix_heap_t* heap, size_t* key)
+{
+    size_t bucket = 0;
+    rh_node_t* node = NULL;
+    rh_node_t* min_node = NULL;
+
+    assert(heap);
+    assert(!RadixHeapIsEmpty(heap));
+
+    while(!heap->buckets[bucket])
+    {
+        ++bucket;
+    }
+
+    min_node = heap->buckets[bucket];
+
+    for(node = min_node->next; bucket != 0 && node; node = node->next)
+    {
+        min_node = node->key < min_node->key ? node : min_node;
+    }
+
+    if(key)
+    {
+        *key = min_node->key;
+    }
+
+    return min_node->data;
+}
+
+size_t RadixHeapSize(const radix_heap_t* heap)
+{
+    assert(heap);
+
+    return heap->size;
+}
+
+int RadixHeapIsEmpty(const radix_heap_t* heap)
+{
+    assert(heap);
+
+    return heap->size == 0;
+}
@@ -0,0 +1,226 @@
+#include <assert.h>         /* assert */
+
+#include "slab.h"
+#include "fsa.h"
+
+#define SLAB_PAGE_SIZE (65536)
+#define GRANULE (8)
+#define N_CLASSES (sizeof(class_sizes) / sizeof(class_sizes[0]))
+
+static const size_t class_sizes[] = {16, 24, 32, 48, 64, 96, 128, 192, 256,
+                                384, 512, 768, 1024, 1536, 2048, 3072, 4096};
+
+/* the fixed size allocator of a page starts right after its header */
+typedef struct slab_page
+{
+    struct slab_page* next;
+    struct slab_page* prev;
+    fsa_t* fsa;
+    size_t size_class;
+    size_t n_used;
+} slab_page_t;
+
+struct slab
+{
+    char* base;
+    size_t n_pages;
+    size_t n_prepared;              /* pages from the start ever used */
+    slab_page_t* free_pages;        /* empty pages of every class */
+    slab_page_t* partial_pages[N_CLASSES];  /* pages with free blocks */
+    unsigned char size_classes[SLAB_MAX_SIZE / GRANULE + 1];
+};
+
+static void InitSizeClasses(slab_t* slab)
+{
+    size_t index = 0;
+    size_t size_class = 0;
+
+    for(; index <= SLAB_MAX_SIZE / GRANULE; ++index)
+    {
+        while(class_sizes[size_class] < index * GRANULE)
+        {
+            ++size_class;
+        }
+
+        slab->size_classes[index] = (unsigned char)size_class;
+    }
+}
+
+static slab_page_t* GetPage(const slab_t* slab, void* block)
+{
+    size_t index = (size_t)((char*)block - slab->base) / SLAB_PAGE_SIZE;
+
+    return (slab_page_t*)(slab->base + index * SLAB_PAGE_SIZE);
+}
+
+static void LinkPage(slab_page_t** list, slab_page_t* page)
+{
+    page->prev = NULL;
+    page->next = *list;
+
+    if(page->next)
+    {
+        page->next->prev = page;
+    }
+
+    *list = page;
+}
+
+static void UnlinkPage(slab_page_t** list, slab_page_t* page)
+{
+    if(page->prev)
+    {
+        page->prev->next = page->next;
+    }
+
+    else
+    {
+        *list = page->next;
+    }
+
+    if(page->next)
+    {
+        page->next->prev = page->prev;
+    }
+}
+
+/* takes an empty page, or prepares one which was never used */
+static slab_page_t* TakePage(slab_t* slab, size_t size_class)
+{
+    slab_page_t* page = slab->free_pages;
+
+    if(page)
+    {
+        UnlinkPage(&slab->free_pages, page);
+    }
+
+    else if(slab->n_prepared < slab->n_pages)
+    {
+        page = (slab_page_t*)(slab->base
+                                        + slab->n_prepared * SLAB_PAGE_SIZE);
+        ++slab->n_prepared;
+    }
+
+    else
+    {
+        return NULL;
+    }
+
+    page->fsa = FSAInit(page + 1, class_sizes[size_class],
+                                        SLAB_PAGE_SIZE - sizeof(slab_page_t));
+    page->size_class = size_class;
+    page->n_used = 0;
+    LinkPage(&slab->partial_pages[size_class], page);
+
+    return page;
+}
+
+/*****************************************************************************/
+
+slab_t* SlabInit(void* memory, size_t memory_size)
+{
+    slab_t* slab = NULL;
+    size_t size_class = 0;
+    size_t offset = 0;
+
+    assert(memory);
+
+    if(memory_size < sizeof(slab_t))
+    {
+        return NULL;
+    }
+
+    /* pages start at a word boundary after the structure */
+    offset = (sizeof(slab_t) + GRANULE - 1) / GRANULE * GRANULE;
+
+    if(memory_size < offset + SLAB_PAGE_SIZE)
+    {
+        return NULL;
+    }
+
+    slab = (slab_t*)memory;
+    slab->base = (char*)memory + offset;
+    slab->n_pages = (memory_size - offset) / SLAB_PAGE_SIZE;
+    slab->n_prepared = 0;
+    slab->free_pages = NULL;
+
+    for(; size_class < N_CLASSES; ++size_class)
+    {
+        slab->partial_pages[size_class] = NULL;
+    }
+
+    InitSizeClasses(slab);
+
+    return slab;
+}
+
+void* SlabAlloc(slab_t* slab, size_t alloc_size)
+{
+    slab_page_t* page = NULL;
+    size_t size_class = 0;
+    void* block = NULL;
+
+    assert(slab);
+
+    if(alloc_size == 0 || alloc_size > SLAB_MAX_SIZE)
+    {
+        return NULL;
+    }
+
+    size_class = slab->size_classes[(alloc_size + GRANULE - 1) / GRANULE];
+    page = slab->partial_pages[size_class];
+
+    if(page == NULL)
+    {
+        page = TakePage(slab, size_class);
+
+        if(page == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    block = FSAAlloc(page->fsa);
+    ++page->n_used;
+
+    if(FSACountFree(page->fsa) == 0)
+    {
+        UnlinkPage(&slab->partial_pages[size_class], page);
+    }
+
+    return block;
+}
+
+void SlabFree(slab_t* slab, void* block)
+{
+    slab_page_t* page = NULL;
+    slab_page_t** partial = NULL;
+
+    assert(slab);
+
+    if(block == NULL)
+    {
+        return;
+    }
+
+    assert((char*)block > slab->base);
+    page = GetPage(slab, block);
+    assert(page->n_used > 0);
+    partial = &slab->partial_pages[page->size_class];
+
+    if(FSACountFree(page->fsa) == 0)
+    {
+        LinkPage(partial, page);
+    }
+
+    FSAFree(page->fsa, block);
+    --page->n_used;
+
+    /* the last page of a class is kept, so a block freed and allocated
+       again does not prepare a page every time */
+    if(page->n_used == 0 && (page->prev || page->next))
+    {
+        UnlinkPage(partial, page);
+        LinkPage(&slab->free_pages, page);
+    }
+}
@@ -0,0 +1,294 @@
+#include <stdlib.h>                  /* malloc, free */
+#include <assert.h>                  /* assert */
+
+#include "timing_wheel.h"
+
+#define SLOT_BITS (6)
+#define N_SLOTS (1 << SLOT_BITS)
+#define SLOT_MASK ((size_t)N_SLOTS - 1)
+#define N_LEVELS (4)
+#define GET_DIGIT(time, level) (((time) >> ((level) * SLOT_BITS)) & SLOT_MASK)
+#define LOW_MASK(level) (((size_t)1 << ((level) * SLOT_BITS)) - 1)
+
+struct tw_timer
+{
+    tw_timer_t* next;
+    tw_timer_t* prev;
+    size_t expires;
+    void* data;
+};
+
+/*
+*   A timer lives in the level of the most significant slot digit in which its
+*   expiration tick differs from the current tick, in the slot of that digit.
+*   Timers further away than all the levels can hold wait in @overflow.
+*/
+struct timing_wheel
+{
+    size_t now;
+    size_t size;
+    tw_timer_t slots[N_LEVELS][N_SLOTS];
+    tw_timer_t overflow;
+};
+
+static void ListInit(tw_timer_t* head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static int ListIsEmpty(const tw_timer_t* head)
+{
+    return head->next == head;
+}
+
+static void ListPushBack(tw_timer_t* head, tw_timer_t* timer)
+{
+    timer->prev = head->prev;
+    timer->next = head;
+    head->prev->next = timer;
+    head->prev = timer;
+}
+
+static void ListUnlink(tw_timer_t* timer)
+{
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+}
+
+static void ListMove(tw_timer_t* dst, tw_timer_t* src)
+{
+    ListInit(dst);
+
+    if(ListIsEmpty(src))
+    {
+        return;
+    }
+
+    dst->next = src->next;
+    dst->prev = src->prev;
+    dst->next->prev = dst;
+    dst->prev->next = dst;
+    ListInit(src);
+}
+
+static void FreeList(tw_timer_t* head)
+{
+    tw_timer_t* timer = head->next;
+    tw_timer_t* next = NULL;
+
+    while(timer != head)
+    {
+        next = timer->next;
+        free(timer);
+        timer = next;
+    }
+}
+
+static void PlaceTimer(timing_wheel_t* wheel, tw_timer_t* timer)
+{
+    size_t diff = timer->expires ^ wheel->now;
+    size_t level = 0;
+
+    if((diff & ~LOW_MASK(N_LEVELS)) != 0)
+    {
+        ListPushBack(&wheel->overflow, timer);
+        return;
+    }
+
+    while(level + 1 < N_LEVELS && (diff & ~LOW_MASK(level + 1)) != 0)
+    {
+        ++level;
+    }
+
+    ListPushBack(&wheel->slots[level][GET_DIGIT(timer->expires, level)],
+                                                                        timer);
+}
+
+static void Cascade(timing_wheel_t* wheel, tw_timer_t* head)
+{
+    tw_timer_t pending;
+    tw_timer_t* timer = NULL;
+
+    ListMove(&pending, head);
+
+    while(!ListIsEmpty(&pending))
+    {
+        timer = pending.next;
+        ListUnlink(timer);
+        PlaceTimer(wheel, timer);
+    }
+}
+
+static size_t Tick(timing_wheel_t* wheel, expire_func_t expire_func,
+                                                                void* param)
+{
+    tw_timer_t due;
+    tw_timer_t* timer = NULL;
+    void* data = NULL;
+    size_t level = 1;
+    size_t count = 0;
+
+    ++wheel->now;
+
+    if(GET_DIGIT(wheel->now, 0) == 0)
+    {
+        while(level + 1 < N_LEVELS && (wheel->now & LOW_MASK(level + 1)) == 0)
+        {
+            ++level;
+        }
+
+        if((wheel->now & LOW_MASK(N_LEVELS)) == 0)
+        {
+            Cascade(wheel, &wheel->overflow);
+        }
+
+        for(; level > 0; --level)
+        {
+            Cascade(wheel, &wheel->slots[level][GET_DIGIT(wheel->now, level)]);
+        }
+    }
+
+    ListMove(&due, &wheel->slots[0][GET_DIGIT(wheel->now, 0)]);
+
+    while(!ListIsEmpty(&due))
+    {
+        timer = due.next;
+        ListUnlink(timer);
+        data = timer->data;
+        free(timer);
+        --wheel->size;
+        ++count;
+        expire_func(data, param);
+    }
+
+    return count;
+}
+
+/*****************************************************************************/
+
+timing_wheel_t* TWCreate(void)
+{
+    timing_wheel_t* wheel = NULL;
+    size_t level = 0;
+    size_t slot = 0;
+
+    wheel = (timing_wheel_t*)malloc(sizeof(timing_wheel_t));
+
+    if(wheel == NULL)
+    {
+        return NULL;
+    }
+
+    for(level = 0; level < N_LEVELS; ++level)
+    {
+        for(slot = 0; slot < N_SLOTS; ++slot)
+        {
+            ListInit(&wheel->slots[level][slot]);
+        }
+    }
+
+    ListInit(&wheel->overflow);
+    wheel->now = 0;
+    wheel->size = 0;
+
+    return wheel;
+}
+
+void TWDestroy(timing_wheel_t* wheel)
+{
+    size_t level = 0;
+    size_t slot = 0;
+
+    assert(wheel);
+
+    for(level = 0; level < N_LEVELS; ++level)
+    {
+        for(slot = 0; slot < N_SLOTS; ++slot)
+        {
+            FreeList(&wheel->slots[level][slot]);
+        }
+    }
+
+    FreeList(&wheel->overflow);
+    free(wheel);
+}
+
+tw_timer_t* TWSchedule(timing_wheel_t* wheel, size_t delay, void* data)
+{
+    tw_timer_t* timer = NULL;
+
+    assert(wheel);
+
+    timer = (tw_timer_t*)malloc(sizeof(tw_timer_t));
+
+    if(timer == NULL)
+    {
+        return NULL;
+    }
+
+    timer->expires = wheel->now + (delay ? delay : 1);
+    timer->data = data;
+    PlaceTimer(wheel, timer);
+    ++wheel->size;
+
+    return timer;
+}
+
+void* TWCancel(timing_wheel_t* wheel, tw_timer_t* timer)
+{
+    void* data = NULL;
+
+    assert(wheel);
+    assert(timer);
+
+    data = timer->data;
+    ListUnlink(timer);
+    free(timer);
+    --wheel->size;
+
+    return data;
+}
+
+size_t TWAdvance(timing_wheel_t* wheel, size_t ticks, expire_func_t expire_func,
+                                                                void* param)
+{
+    size_t count = 0;
+
+    assert(wheel);
+    assert(expire_func);
+
+    for(; ticks > 0; --ticks)
+    {
+        if(wheel->size == 0)
+        {
+            wheel->now += ticks;
+            break;
+        }
+
+        count += Tick(wheel, expire_func, param);
+    }
+
+    return count;
+}
+
+size_t TWGetTime(const timing_wheel_t* wheel)
+{
+    assert(wheel);
+
+    return wheel->now;
+}
+
+size_t TWSize(const timing_wheel_t* wheel)
+{
+    assert(wheel);
+
+    return wheel->size;
+}
+
+int TWIsEmpty(const timing_wheel_t* wheel)
+{
+    assert(wheel);
+
+    return wheel->size == 0;
+}
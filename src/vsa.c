@@ -1,4 +1,10 @@
-#include <assert.h>
+#define _DEFAULT_SOURCE      /* MAP_ANONYMOUS, madvise */
+
+#include <assert.h>         /* assert */
+#include <stddef.h>         /* offsetof */
+#include <string.h>         /* memcpy */
+#include <sys/mman.h>       /* mmap, munmap, mprotect, madvise */
+#include <unistd.h>         /* sysconf */
 
 #include "vsa.h"
 
@@ -10,6 +16,7 @@
 typedef struct block_header
 {
     long block_size;
+    vsa_t* vsa;         /* owner of an allocated block, for @VSAFree */
 #ifndef NDEBUG
     size_t magic_num;
 #endif
@@ -17,6 +24,12 @@ typedef struct block_header
 
 struct vsa
 {
+    size_t reserved;    /* bytes reserved by @VSACreateGrowable, 0 if fixed */
+    size_t committed;   /* bytes in use from the start of @vsa */
+    size_t bytes_in_use;
+    size_t peak_bytes_in_use;
+    size_t blocks_in_use;
+    size_t free_blocks;
     block_header_t first_header;
 };
 
@@ -35,7 +48,7 @@ static int IsFree(block_header_t* header)
     return header->block_size > 0;
 }
 
-static void Defrag(block_header_t* header)
+static void Defrag(vsa_t* vsa, block_header_t* header)
 {
     block_header_t* header_runner = NULL;
 
@@ -49,11 +62,93 @@ static void Defrag(block_header_t* header)
     while(IsFree(header_runner))
     {
         header->block_size += header_runner->block_size + HEADER_SIZE;
+        --vsa->free_blocks;
         header_runner = GetNextHeader(header_runner);
     }
 }
 
-static void* AllocBlock(block_header_t* header, size_t alloc_size)
+static size_t GetPageSize(void)
+{
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static size_t AlignPage(size_t size)
+{
+    size_t page_size = GetPageSize();
+
+    return ((size + page_size - 1) / page_size) * page_size;
+}
+
+static size_t GetOffset(vsa_t* vsa, void* address)
+{
+    return (size_t)((char*)address - (char*)vsa);
+}
+
+static void SetEnd(vsa_t* vsa, size_t end)
+{
+    block_header_t* last_header = (block_header_t*)((char*)vsa + end
+                                                                - HEADER_SIZE);
+
+    last_header->block_size = 0;
+#ifndef NDEBUG
+    last_header->magic_num = MAGIC_NUMBER;
+#endif
+    vsa->committed = end;
+}
+
+/*
+*   commits the pages needed for @tail to hold @alloc_size, @tail is either the
+*   free block before the end or the end itself, which becomes a free block
+*/
+static block_header_t* Grow(vsa_t* vsa, block_header_t* tail,
+                                                            size_t alloc_size)
+{
+    size_t end = AlignPage(GetOffset(vsa, tail + 1) + alloc_size
+                                                                + HEADER_SIZE);
+
+    /* @tail is a free block which already holds @alloc_size */
+    if(end <= vsa->committed)
+    {
+        return tail;
+    }
+
+    if(end > vsa->reserved)
+    {
+        return NULL;
+    }
+
+    if(mprotect((char*)vsa + vsa->committed, end - vsa->committed,
+                                                    PROT_READ | PROT_WRITE))
+    {
+        return NULL;
+    }
+
+    if(tail->block_size == 0)
+    {
+        ++vsa->free_blocks;
+    }
+
+    tail->block_size = (long)(end - HEADER_SIZE - GetOffset(vsa, tail + 1));
+#ifndef NDEBUG
+    tail->magic_num = MAGIC_NUMBER;
+#endif
+    SetEnd(vsa, end);
+
+    return tail;
+}
+
+static void AddInUse(vsa_t* vsa, size_t bytes)
+{
+    vsa->bytes_in_use += bytes;
+
+    if(vsa->bytes_in_use > vsa->peak_bytes_in_use)
+    {
+        vsa->peak_bytes_in_use = vsa->bytes_in_use;
+    }
+}
+
+static void* AllocBlock(vsa_t* vsa, block_header_t* header,
+                                                            size_t alloc_size)
 {
     block_header_t* new_header = NULL;
 
@@ -67,8 +162,13 @@ static void* AllocBlock(block_header_t* header, size_t alloc_size)
     else
     {
         header->block_size *= -1;
+        --vsa->free_blocks;
     }
 
+    header->vsa = vsa;
+    AddInUse(vsa, -header->block_size);
+    ++vsa->blocks_in_use;
+
 #ifndef NDEBUG
     header->magic_num = MAGIC_NUMBER;      
 #endif
@@ -76,6 +176,61 @@ static void* AllocBlock(block_header_t* header, size_t alloc_size)
     return header + 1;
 }
 
+/*
+*   bytes to skip from the start of @header so the block starts aligned to
+*   @align, the skipped bytes must hold a free block of their own
+*/
+static size_t GetPadding(block_header_t* header, size_t align)
+{
+    size_t address = (size_t)(header + 1);
+    size_t padding = (align - address % align) % align;
+
+    while(padding != 0 && padding <= HEADER_SIZE)
+    {
+        padding += align;
+    }
+
+    return padding;
+}
+
+static void* AllocAlignedBlock(vsa_t* vsa, block_header_t* header,
+                                            size_t alloc_size, size_t align)
+{
+    block_header_t* aligned_header = NULL;
+    size_t padding = GetPadding(header, align);
+
+    if(header->block_size < (long)(alloc_size + padding))
+    {
+        return NULL;
+    }
+
+    if(padding != 0)
+    {
+        aligned_header = (block_header_t*)((char*)header + padding);
+        aligned_header->block_size = header->block_size - padding;
+        header->block_size = padding - HEADER_SIZE;
+        header = aligned_header;
+        ++vsa->free_blocks;
+    }
+
+    return AllocBlock(vsa, header, alloc_size);
+}
+
+/* frees the end of the allocated @header past @alloc_size, if it fits a
+   block */
+static void ShrinkBlock(block_header_t* header, size_t alloc_size)
+{
+    block_header_t* rest = NULL;
+    long block_size = -header->block_size;
+
+    if(block_size > (long)(alloc_size + HEADER_SIZE))
+    {
+        rest = (block_header_t*)((char*)(header + 1) + alloc_size);
+        rest->block_size = block_size - alloc_size - HEADER_SIZE;
+        header->block_size = -(long)alloc_size;
+        ++header->vsa->free_blocks;
+    }
+}
 
 vsa_t* VSAInit(void* memory, size_t memory_size)
 {
@@ -84,13 +239,19 @@ vsa_t* VSAInit(void* memory, size_t memory_size)
 
     assert(memory);
     
-    if(memory_size <= 2 * HEADER_SIZE)
+    if(memory_size <= sizeof(vsa_t) + HEADER_SIZE)
     {
         return NULL;
     }
 
     vsa = (vsa_t*)memory;
-    vsa->first_header.block_size = memory_size - 2 * HEADER_SIZE;
+    vsa->reserved = 0;
+    vsa->committed = memory_size;
+    vsa->bytes_in_use = 0;
+    vsa->peak_bytes_in_use = 0;
+    vsa->blocks_in_use = 0;
+    vsa->free_blocks = 1;
+    vsa->first_header.block_size = memory_size - sizeof(vsa_t) - HEADER_SIZE;
     last_header = GetNextHeader(&vsa->first_header);
     last_header->block_size = 0;
 
@@ -102,9 +263,49 @@ vsa_t* VSAInit(void* memory, size_t memory_size)
     return vsa;
 }
 
+vsa_t* VSACreateGrowable(size_t max_size)
+{
+    vsa_t* vsa = NULL;
+    void* memory = NULL;
+    size_t reserved = AlignPage(max_size);
+
+    if(reserved < GetPageSize())
+    {
+        return NULL;
+    }
+
+    memory = mmap(NULL, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                                                                            0);
+
+    if(memory == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    if(mprotect(memory, GetPageSize(), PROT_READ | PROT_WRITE))
+    {
+        munmap(memory, reserved);
+        return NULL;
+    }
+
+    vsa = VSAInit(memory, GetPageSize());
+    vsa->reserved = reserved;
+
+    return vsa;
+}
+
+void VSADestroy(vsa_t* vsa)
+{
+    assert(vsa);
+    assert(vsa->reserved);
+
+    munmap(vsa, vsa->reserved);
+}
+
 void* VSAAlloc(vsa_t* vsa, size_t alloc_size)
 {
     block_header_t* header = NULL;
+    block_header_t* last_free = NULL;
 
     assert(vsa);
 
@@ -117,16 +318,136 @@ void* VSAAlloc(vsa_t* vsa, size_t alloc_size)
     header = &vsa->first_header;
     while(header->block_size != 0) 
     {
-        Defrag(header);
+        Defrag(vsa, header);
         if(header->block_size >= (long)alloc_size)
         {
-            return AllocBlock(header, alloc_size);
+            return AllocBlock(vsa, header, alloc_size);
+        }
+
+        last_free = IsFree(header) ? header : NULL;
+        header = GetNextHeader(header);
+    }
+
+    if(vsa->reserved == 0)
+    {
+        return NULL;
+    }
+
+    header = Grow(vsa, last_free ? last_free : header, alloc_size);
+
+    return header ? AllocBlock(vsa, header, alloc_size) : NULL;
+}
+
+void* VSAAllocAligned(vsa_t* vsa, size_t alloc_size, size_t align)
+{
+    block_header_t* header = NULL;
+    block_header_t* last_free = NULL;
+    void* block = NULL;
+
+    assert(vsa);
+    assert(align != 0 && (align & (align - 1)) == 0);
+
+    if(align <= WORD_SIZE)
+    {
+        return VSAAlloc(vsa, alloc_size);
+    }
+
+    if(alloc_size == 0)
+    {
+        return NULL;
+    }
+
+    alloc_size = AlignBlock(alloc_size);
+    header = &vsa->first_header;
+    while(header->block_size != 0)
+    {
+        Defrag(vsa, header);
+        block = AllocAlignedBlock(vsa, header, alloc_size, align);
+
+        if(block)
+        {
+            return block;
         }
 
+        last_free = IsFree(header) ? header : NULL;
         header = GetNextHeader(header);
     }
 
-    return NULL;
+    if(vsa->reserved == 0)
+    {
+        return NULL;
+    }
+
+    /* room for the most padding @GetPadding can ask for */
+    header = Grow(vsa, last_free ? last_free : header,
+                                        alloc_size + align + HEADER_SIZE);
+
+    return header ? AllocAlignedBlock(vsa, header, alloc_size, align) : NULL;
+}
+
+void* VSARealloc(vsa_t* vsa, void* block, size_t new_size)
+{
+    block_header_t* header = NULL;
+    block_header_t* next = NULL;
+    block_header_t* tail = NULL;
+    size_t block_size = 0;
+    size_t old_size = 0;
+    void* new_block = NULL;
+
+    assert(vsa);
+
+    if(block == NULL)
+    {
+        return VSAAlloc(vsa, new_size);
+    }
+
+    if(new_size == 0)
+    {
+        VSAFree(block);
+        return NULL;
+    }
+
+    header = (block_header_t*)block - 1;
+    assert(header->magic_num == MAGIC_NUMBER);
+    new_size = AlignBlock(new_size);
+    block_size = -header->block_size;
+    old_size = block_size;
+    next = GetNextHeader(header);
+    Defrag(vsa, next);
+
+    /* the last block of a growable pool grows into new pages */
+    tail = IsFree(next) ? GetNextHeader(next) : next;
+    if(block_size + HEADER_SIZE + (IsFree(next) ? next->block_size : 0)
+                < new_size && vsa->reserved && tail->block_size == 0)
+    {
+        Grow(vsa, next, new_size - block_size);
+    }
+
+    if(IsFree(next) && block_size + HEADER_SIZE + next->block_size >= new_size)
+    {
+        header->block_size -= next->block_size + HEADER_SIZE;
+        block_size = -header->block_size;
+        --vsa->free_blocks;
+    }
+
+    if(block_size >= new_size)
+    {
+        ShrinkBlock(header, new_size);
+        vsa->bytes_in_use -= old_size;
+        AddInUse(vsa, -header->block_size);
+
+        return block;
+    }
+
+    new_block = VSAAlloc(vsa, new_size);
+
+    if(new_block)
+    {
+        memcpy(new_block, block, block_size);
+        VSAFree(block);
+    }
+
+    return new_block;
 }
 
 void VSAFree(void* block)
@@ -138,6 +459,9 @@ void VSAFree(void* block)
         header = (block_header_t*)block - 1;
         assert(header->magic_num == MAGIC_NUMBER);
         header->block_size *= -1;
+        header->vsa->bytes_in_use -= header->block_size;
+        --header->vsa->blocks_in_use;
+        ++header->vsa->free_blocks;
     }
 }
 
@@ -151,11 +475,166 @@ size_t VSALargestChunkAvailable(vsa_t* vsa)
     header = &vsa->first_header;
     while(header->block_size != 0)
     {
-        Defrag(header);
+        Defrag(vsa, header);
         max_size = header->block_size > max_size ? header->block_size
                                                     : max_size;
         header = GetNextHeader(header);
     }
 
     return (size_t)max_size;
-}
\ No newline at end of file
+}
+
+size_t VSATrim(vsa_t* vsa)
+{
+    block_header_t* header = NULL;
+    block_header_t* last_free = NULL;
+    size_t offset = 0;
+    size_t end = 0;
+    size_t released = 0;
+
+    assert(vsa);
+
+    if(vsa->reserved == 0)
+    {
+        return 0;
+    }
+
+    header = &vsa->first_header;
+    while(header->block_size != 0)
+    {
+        Defrag(vsa, header);
+        last_free = IsFree(header) ? header : NULL;
+        header = GetNextHeader(header);
+    }
+
+    if(last_free == NULL)
+    {
+        return 0;
+    }
+
+    /* the free block either becomes the end or keeps the rest of the page
+       the end lies in, with room for at least a word */
+    offset = GetOffset(vsa, last_free);
+    end = AlignPage(offset + HEADER_SIZE);
+
+    if(end != offset + HEADER_SIZE && end < offset + 2 * HEADER_SIZE
+                                                                + WORD_SIZE)
+    {
+        end += GetPageSize();
+    }
+
+    if(end >= vsa->committed)
+    {
+        return 0;
+    }
+
+    released = vsa->committed - end;
+    madvise((char*)vsa + end, released, MADV_DONTNEED);
+    mprotect((char*)vsa + end, released, PROT_NONE);
+
+    if(end == offset + HEADER_SIZE)
+    {
+        --vsa->free_blocks;
+    }
+
+    else
+    {
+        last_free->block_size = (long)(end - offset - 2 * HEADER_SIZE);
+    }
+
+    SetEnd(vsa, end);
+
+    return released;
+}
+
+void VSAGetStats(const vsa_t* vsa, vsa_stats_t* stats)
+{
+    size_t headers = 0;
+
+    assert(vsa);
+    assert(stats);
+
+    /* every block and the end of the pool have a header */
+    headers = (vsa->blocks_in_use + vsa->free_blocks + 1) * HEADER_SIZE;
+
+    stats->bytes_in_use = vsa->bytes_in_use;
+    stats->peak_bytes_in_use = vsa->peak_bytes_in_use;
+    stats->blocks_in_use = vsa->blocks_in_use;
+    stats->bytes_free = vsa->committed - offsetof(vsa_t, first_header)
+                                                - headers - vsa->bytes_in_use;
+    stats->free_blocks = vsa->free_blocks;
+}
+
+static size_t GetBucket(size_t block_size, size_t n_buckets)
+{
+    size_t bucket = 0;
+
+    while(block_size > 1 && bucket < n_buckets - 1)
+    {
+        block_size >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+void VSAGetHistogram(vsa_t* vsa, size_t* used_histogram,
+                                    size_t* free_histogram, size_t n_buckets,
+                                    size_t* largest_free, size_t* bytes_free)
+{
+    block_header_t* header = NULL;
+    size_t index = 0;
+    size_t* histogram = NULL;
+    size_t largest = 0;
+    size_t total = 0;
+
+    assert(vsa);
+    assert(n_buckets > 0);
+
+    for(index = 0; index < n_buckets; ++index)
+    {
+        if(used_histogram)
+        {
+            used_histogram[index] = 0;
+        }
+
+        if(free_histogram)
+        {
+            free_histogram[index] = 0;
+        }
+    }
+
+    header = &vsa->first_header;
+    while(header->block_size != 0)
+    {
+        Defrag(vsa, header);
+        histogram = IsFree(header) ? free_histogram : used_histogram;
+
+        if(histogram)
+        {
+            ++histogram[GetBucket(ABS(header->block_size), n_buckets)];
+        }
+
+        if(IsFree(header))
+        {
+            total += header->block_size;
+
+            if((size_t)header->block_size > largest)
+            {
+                largest = header->block_size;
+            }
+        }
+
+        header = GetNextHeader(header);
+    }
+
+    if(largest_free)
+    {
+        *largest_free = largest;
+    }
+
+    if(bytes_free)
+    {
+        *bytes_free = total;
+    }
+}